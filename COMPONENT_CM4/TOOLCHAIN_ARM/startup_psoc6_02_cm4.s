@@ -254,6 +254,22 @@ Reset_Handler   PROC
                 IMPORT  Cy_SystemInitFpuEnable
                 IMPORT  __main
 
+                IF :DEF:CYBSP_MEM_USAGE
+                IMPORT |Image$$ARM_LIB_HEAP$$ZI$$Base|
+
+                ; Paint the heap and the stack, which are adjacent, up to the initial stack pointer.
+                ; cybsp_mem_usage_get() finds the high-watermarks from the pattern, which must
+                ; match CYBSP_MEM_USAGE_PAINT.
+                LDR     r0, =|Image$$ARM_LIB_HEAP$$ZI$$Base|
+                MOV     r1, sp
+                LDR     r2, =0xA5A5A5A5
+Mem_Paint
+                CMP     r0, r1
+                ITT     LO
+                STRLO   r2, [r0], #4
+                BLO     Mem_Paint
+                ENDIF
+
                 ; Define strong function for startup customization
                 BL      Cy_OnResetUser
 
@@ -30,16 +30,22 @@
 ################################################################################
 
 ### CM4 ###
-export HEAP_SIZE_CM4     := 0x400
+export HEAP_SIZE_CM4     := $(if $(CYBSP_HEAP_SIZE),$(CYBSP_HEAP_SIZE),0x400)
 export VECT_BASE_CM4     := 0x10180000
 export RAM_VECT_BASE_CM4 := 0x08080000
 export VECT_SIZE_CM4     := 0x000002E0
 export TEXT_BASE_CM4     := 0x101802E0
 export TEXT_SIZE_CM4     := 0x00080000
 export RAM_BASE_CM4      := 0x080802E0
-export RAM_SIZE_CM4      := 0x0007F800
+# Shared SRAM at the end of the CM4 RAM (CYBSP_SHAREDMEM_SIZE, see bsp.mk), must match
+# CYBSP_SHAREDMEM_START
+SHAREDMEM_SIZE_CM4       := $(if $(CYBSP_SHAREDMEM_SIZE),$(CYBSP_SHAREDMEM_SIZE),0)
+export RAM_SIZE_CM4      := $(shell printf "0x%x" $$((0x0007F800 - $(SHAREDMEM_SIZE_CM4))))
+export SHAREDMEM_BASE_CM4 := $(shell printf "0x%x" $$((0x080FF800 - $(SHAREDMEM_SIZE_CM4))))
 export CYMETA_BASE_CM4   := 0x90500000
-export STACK_SIZE_CM4    := 0x1000
+# Memory mapped QSPI flash (CYBSP_XIP)
+export XIP_BASE_CM4      := 0x18000000
+export STACK_SIZE_CM4    := $(if $(CYBSP_STACK_SIZE),$(CYBSP_STACK_SIZE),0x1000)
 STACK_ADDRESS_TOP_CM4    := $(shell printf "0x%x" $$(($(RAM_VECT_BASE_CM4) + $(RAM_SIZE_CM4))))
 STACK_ADDRESS_BOTTOM_CM4 := $(shell printf "0x%x" $$(($(STACK_ADDRESS_TOP_CM4) - $(STACK_SIZE_CM4))))
 TOOLCHAIN_VECT_BASE_CM4  := $(VECT_BASE_CM4)
@@ -50,6 +56,8 @@ SECTIONS_CM4 := \
     -segaddr __DATA $(RAM_BASE_CM4) \
     -segaddr __RAMVECTORS $(RAM_VECT_BASE_CM4) \
     -segaddr __CYMETA $(CYMETA_BASE_CM4) \
+    -segaddr __SHAREDMEM $(SHAREDMEM_BASE_CM4) \
+    -segaddr __XIP $(XIP_BASE_CM4) \
     -segaddr __STACK $(STACK_ADDRESS_TOP_CM4)
 
 # Pass section addresses to the linker
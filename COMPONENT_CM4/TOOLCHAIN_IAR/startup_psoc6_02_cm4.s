@@ -43,6 +43,9 @@
 
         ;; Forward declaration of sections.
         SECTION CSTACK:DATA:NOROOT(3)
+#ifdef CYBSP_MEM_USAGE
+        SECTION HEAP:DATA:NOROOT(3)
+#endif
         SECTION .intvec_ram:DATA:NOROOT(2)
         SECTION .intvec:CODE:NOROOT(2)
 
@@ -315,6 +318,20 @@ __low_level_init
         SECTION .text:CODE:REORDER:NOROOT(2)
 Reset_Handler
 
+#ifdef CYBSP_MEM_USAGE
+        ; Paint the heap and the stack, which are adjacent, up to the initial stack pointer.
+        ; cybsp_mem_usage_get() finds the high-watermarks from the pattern, which must
+        ; match CYBSP_MEM_USAGE_PAINT.
+        LDR     R0, =sfb(HEAP)
+        MOV     R1, SP
+        LDR     R2, =0xA5A5A5A5
+mem_paint
+        CMP     R0, R1
+        ITT     LO
+        STRLO   R2, [R0], #4
+        BLO     mem_paint
+#endif
+
         ; Define strong function for startup customization
         LDR     R0, =Cy_OnResetUser
         BLX     R0
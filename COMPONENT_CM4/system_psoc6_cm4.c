@@ -44,6 +44,16 @@
     #include "cy_pra.h"
 #endif /* defined(CY_DEVICE_SECURE) */
 
+/* The boot profiler macros expand to nothing unless CYBSP_BOOT_PROFILE is defined */
+#include "cybsp_boot_profile.h"
+#include "cybsp_ramfunc.h"
+#if defined(CYBSP_XIP)
+    #include "cybsp_xip.h"
+#endif /* defined(CYBSP_XIP) */
+#if defined(CYBSP_WARM_BOOT)
+    #include "cybsp_warm_boot.h"
+#endif /* defined(CYBSP_WARM_BOOT) */
+
 
 /*******************************************************************************
 * SystemCoreClockUpdate()
@@ -104,10 +114,21 @@ uint8_t cy_delayFreqMhz  = (uint8_t)CY_SYSLIB_DIV_ROUNDUP(CY_CLK_SYSTEM_FREQ_HZ_
 
 void SystemInit(void)
 {
+    CYBSP_BOOT_PROFILE_BEGIN(CYBSP_BOOT_PHASE_SYSTEM_INIT);
+
+#if defined(CYBSP_WARM_BOOT) && !defined(CYBSP_WARM_BOOT_IN_RESET_HANDLER)
+    /* Classify the boot before anything else runs; GCC_ARM does this in Reset_Handler */
+    (void)cybsp_warm_boot_early_init();
+#endif /* defined(CYBSP_WARM_BOOT) && !defined(CYBSP_WARM_BOOT_IN_RESET_HANDLER) */
+
+    CYBSP_BOOT_PROFILE_BEGIN(CYBSP_BOOT_PHASE_PDL_INIT);
     Cy_PDL_Init(CY_DEVICE_CFG);
+    CYBSP_BOOT_PROFILE_END(CYBSP_BOOT_PHASE_PDL_INIT);
 
 #ifdef __CM0P_PRESENT
     #if (__CM0P_PRESENT == 0)
+        CYBSP_BOOT_PROFILE_BEGIN(CYBSP_BOOT_PHASE_WDT_DISABLE);
+
         /* Restore FLL registers to the default state as they are not restored by the ROM code */
         uint32_t copy = SRSS->CLK_FLL_CONFIG;
         copy &= ~SRSS_CLK_FLL_CONFIG_FLL_ENABLE_Msk;
@@ -125,6 +146,8 @@ void SystemInit(void)
         /* Unlock and disable WDT */
         Cy_WDT_Unlock();
         Cy_WDT_Disable();
+
+        CYBSP_BOOT_PROFILE_END(CYBSP_BOOT_PHASE_WDT_DISABLE);
     #endif /* (__CM0P_PRESENT == 0) */
 #endif /* __CM0P_PRESENT */
 
@@ -144,6 +167,8 @@ void SystemInit(void)
 
 #if !defined(CY_IPC_DEFAULT_CFG_DISABLE)
 
+    CYBSP_BOOT_PROFILE_BEGIN(CYBSP_BOOT_PHASE_IPC_INIT);
+
 #ifdef __CM0P_PRESENT
     #if (__CM0P_PRESENT == 0)
         /* Allocate and initialize semaphores for the system operations. */
@@ -202,8 +227,12 @@ void SystemInit(void)
 
     Cy_IPC_Pipe_Init(&systemIpcPipeConfigCm4);
 
+    CYBSP_BOOT_PROFILE_END(CYBSP_BOOT_PHASE_IPC_INIT);
+
 #if defined(CY_DEVICE_PSOC6ABLE2)
+    CYBSP_BOOT_PROFILE_BEGIN(CYBSP_BOOT_PHASE_FLASH_INIT);
     Cy_Flash_Init();
+    CYBSP_BOOT_PROFILE_END(CYBSP_BOOT_PHASE_FLASH_INIT);
 #endif /* defined(CY_DEVICE_PSOC6ABLE2) */
 
 #endif /* !defined(CY_IPC_DEFAULT_CFG_DISABLE) */
@@ -212,6 +241,15 @@ void SystemInit(void)
     /* Initialize Protected Register Access driver */
     Cy_PRA_Init();
 #endif /* defined(CY_DEVICE_SECURE) */
+
+#if defined(CYBSP_XIP)
+    /* Map the QSPI flash before any code or data placed in it can be accessed */
+    CYBSP_BOOT_PROFILE_BEGIN(CYBSP_BOOT_PHASE_XIP_INIT);
+    cybsp_xip_early_init();
+    CYBSP_BOOT_PROFILE_END(CYBSP_BOOT_PHASE_XIP_INIT);
+#endif /* defined(CYBSP_XIP) */
+
+    CYBSP_BOOT_PROFILE_END(CYBSP_BOOT_PHASE_SYSTEM_INIT);
 }
 
 
@@ -286,10 +324,12 @@ void Cy_SystemInitFpuEnable(void)
 * This is the interrupt service routine for the system pipe.
 *
 *******************************************************************************/
+CYBSP_RAMFUNC_BEGIN
 void Cy_SysIpcPipeIsrCm4(void)
 {
     Cy_IPC_Pipe_ExecuteCallback(CY_IPC_EP_CYPIPE_CM4_ADDR);
 }
+CYBSP_RAMFUNC_END
 #endif
 
 
@@ -23,6 +23,8 @@
 #include "cybsp_bt_config.h"
 #include "cycfg_connectivity_bt.h"
 #include "wiced_bt_dev.h"
+#include "cy_sysclk.h"
+#include "cybsp.h"
 
 // Not all boards use all of these pins. Any that arn't defined we will fallback on No Connects.
 #if !defined(CYBSP_BT_POWER)
@@ -89,4 +91,36 @@ const cybt_platform_config_t cybsp_bt_platform_cfg =
     .task_mem_pool_size                     = CYBSP_BT_PLATFORM_CFG_MEM_POOL_BYTES
 };
 
+
+//--------------------------------------------------------------------------------------------------
+// cybsp_bt_check_baud
+//--------------------------------------------------------------------------------------------------
+cy_rslt_t cybsp_bt_check_baud(uint32_t baud, uint32_t* error_ppm)
+{
+    uint32_t clk_peri = Cy_SysClk_ClkPeriGetFrequency();
+    uint32_t best_ppm = UINT32_MAX;
+
+    for (uint32_t oversample = 8u; (0u != baud) && (oversample <= 16u); oversample++)
+    {
+        uint64_t bit_clk = (uint64_t)baud * oversample;
+        uint32_t divider = (uint32_t)(((uint64_t)clk_peri + (bit_clk / 2u)) / bit_clk);
+        if ((0u != divider) && (divider <= 65536u))
+        {
+            uint64_t actual = (uint64_t)clk_peri / ((uint64_t)divider * oversample);
+            uint64_t diff   = (actual > baud) ? (actual - baud) : (baud - actual);
+            uint32_t ppm    = (uint32_t)((diff * 1000000u) / baud);
+            if (ppm < best_ppm)
+            {
+                best_ppm = ppm;
+            }
+        }
+    }
+
+    if (NULL != error_ppm)
+    {
+        *error_ppm = best_ppm;
+    }
+    return (best_ppm <= CYBSP_BT_HCI_BAUD_TOLERANCE_PPM) ? CY_RSLT_SUCCESS : CYBSP_RSLT_ERR_BT_BAUD;
+}
+
 #endif /* defined(COMPONENT_WICED_BLE) || defined(COMPONENT_WICED_DUALMODE) */
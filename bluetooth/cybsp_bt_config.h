@@ -22,6 +22,32 @@
  * \addtogroup group_bsp_bt Bluetooth Configuration Structure
  * \{
  * Basic configuration structure for the Bluetooth interface on this board.
+ *
+ * When CYBSP_BT_HCI_HIGH_SPEED is defined, both the patchram download and the feature rate
+ * default to \ref CYBSP_BT_HCI_HIGH_SPEED_BAUD instead of 115200. The HCI UART is owned by the
+ * Bluetooth stack, which allocates its SCB clock divider through the HAL at runtime, so the rate
+ * depends on CLK_PERI: use \ref cybsp_bt_check_baud to validate it against the active clock
+ * configuration. Hardware flow control is always enabled.
+ *
+ * The patchram download is run by the Bluetooth stack's own HCI task: wiced_bt_stack_init()
+ * returns right away and BTM_ENABLED_EVT reports the end of the download. Calling it right after
+ * \ref cybsp_init, before starting the Wi-Fi connection manager, therefore overlaps the download
+ * with the SCL Wi-Fi bring-up running on the network processor. The stack power cycles the
+ * controller through CYBSP_BT_POWER on every start, so the patch is always downloaded again, also
+ * after a warm reset of the PSoC 6.
+ *
+ * The device wake (P12_2) and host wake (P12_3) lines are assigned in the connectivity_bt
+ * personality of design.modus. Like CYBSP_BT_POWER they carry no pin personality: the Bluetooth
+ * stack opens them with cyhal_gpio_init() and sets their drive mode and interrupt edge itself. The
+ * controller then runs in LP mode with wake signalling: the host deasserts device wake to let the
+ * controller sleep, and the controller asserts host wake before sending HCI traffic. The stack only
+ * blocks deep sleep while the HCI UART is active, and the host wake GPIO interrupt wakes the CM4
+ * from deep sleep. For a host that sleeps until host wake fires, combine this with
+ * CYBSP_SLEEP_POLICY (and CYBSP_TICKLESS_IDLE with FreeRTOS) so deep sleep is not locked
+ * permanently. CYBSP_PM_LATENCY measures the wake-to-running latency of these wakeups.
+ *
+ * \note Do not combine LP mode with CYBSP_PM_FAST_WAKE: CLK_PERI runs from the IMO until the PLL
+ * has relocked, so traffic arriving right after host wake would be received at the wrong rate.
  */
 #pragma once
 
@@ -34,15 +60,40 @@
 extern "C" {
 #endif
 
+#if defined(CYBSP_BT_HCI_HIGH_SPEED) && !defined(CYBSP_BT_HCI_HIGH_SPEED_BAUD)
+/**
+ * Rate of the high-speed HCI UART profile. The nominal 100 MHz CLK_PERI generates 3.0303 Mbaud
+ * (11x oversampling, divider 3), 1.01% above the requested rate.
+ */
+#define CYBSP_BT_HCI_HIGH_SPEED_BAUD            (3000000)
+#endif
+
+#if !defined(CYBSP_BT_HCI_BAUD_TOLERANCE_PPM)
+/**
+ * Largest baud rate error accepted by \ref cybsp_bt_check_baud, in parts per million. 2% leaves
+ * the 1.01% of \ref CYBSP_BT_HCI_HIGH_SPEED_BAUD at the nominal CLK_PERI within the budget of
+ * an asynchronous receiver, with room for the error of the controller's own clock.
+ */
+#define CYBSP_BT_HCI_BAUD_TOLERANCE_PPM         (20000u)
+#endif
+
 #if !defined(CYBSP_BT_PLATFORM_CFG_BAUD_DOWNLOAD)
+#if defined(CYBSP_BT_HCI_HIGH_SPEED)
+#define CYBSP_BT_PLATFORM_CFG_BAUD_DOWNLOAD     (CYBSP_BT_HCI_HIGH_SPEED_BAUD)
+#else
 /** If not already defined, the baud rate to download data at. */
 #define CYBSP_BT_PLATFORM_CFG_BAUD_DOWNLOAD     (115200)
 #endif
+#endif
 
 #if !defined(CYBSP_BT_PLATFORM_CFG_BAUD_FEATURE)
+#if defined(CYBSP_BT_HCI_HIGH_SPEED)
+#define CYBSP_BT_PLATFORM_CFG_BAUD_FEATURE      (CYBSP_BT_HCI_HIGH_SPEED_BAUD)
+#else
 /** If not already defined, the baud rate for general operation. */
 #define CYBSP_BT_PLATFORM_CFG_BAUD_FEATURE      (115200)
 #endif
+#endif
 
 #if !defined(CYBSP_BT_PLATFORM_CFG_BITS_DATA)
 /** If not already defined, the number of data bits to transmit. */
@@ -55,7 +106,13 @@ extern "C" {
 #endif
 
 #if !defined(CYBSP_BT_PLATFORM_CFG_MEM_POOL_BYTES)
-/** If not already defined, the number of bytes to allocated for the task memory pool. */
+/**
+ * If not already defined, the number of bytes to allocated for the task memory pool.
+ * The pool holds the messages passed between the Bluetooth stack tasks and is allocated by
+ * btstack-integration when the stack starts, so its placement and usage statistics are not
+ * controlled by the BSP. Raise it when the stack reports task memory allocation failures under
+ * load; \ref group_bsp_mem_usage shows the heap headroom available for it.
+ */
 #define CYBSP_BT_PLATFORM_CFG_MEM_POOL_BYTES    (2048)
 #endif
 
@@ -67,6 +124,18 @@ extern "C" {
 /** Bluetooth platform configuration settings for the board. */
 extern const cybt_platform_config_t cybsp_bt_platform_cfg;
 
+/**
+ * \brief Checks that the HCI UART can run at a baud rate with the current CLK_PERI.
+ * Mirrors the HAL, which picks the oversampling factor (8 to 16) and integer clock divider with
+ * the smallest error. Call it after changing the clock configuration, before starting the stack.
+ * \param baud      Baud rate to check
+ * \param error_ppm Filled with the relative error of the closest achievable rate in parts per
+ *                  million, may be NULL
+ * \returns CY_RSLT_SUCCESS if the error is within \ref CYBSP_BT_HCI_BAUD_TOLERANCE_PPM, otherwise
+ *          CYBSP_RSLT_ERR_BT_BAUD
+ */
+cy_rslt_t cybsp_bt_check_baud(uint32_t baud, uint32_t* error_ppm);
+
 #ifdef __cplusplus
 }
 #endif // __cplusplus
@@ -42,6 +42,70 @@ $(SEARCH_whd-bsp-integration)\
 $(SEARCH_wifi-host-driver)\
 $(SEARCH_wifi-mw-core)\configs
 
+# CM4 main stack size and minimum heap size in bytes. The heap grows to the
+# remaining SRAM (except with A_Clang, which uses a fixed heap). Override in the
+# application Makefile; the values are passed to the startup code and to the
+# linker of every toolchain.
+CYBSP_STACK_SIZE?=0x1000
+CYBSP_HEAP_SIZE?=0x400
+
+ifeq ($(TOOLCHAIN),GCC_ARM)
+ASFLAGS+=-D__STACK_SIZE=$(CYBSP_STACK_SIZE) -D__HEAP_SIZE=$(CYBSP_HEAP_SIZE)
+LDFLAGS+=-Wl,--defsym=__STACK_SIZE=$(CYBSP_STACK_SIZE) -Wl,--defsym=__HEAP_SIZE=$(CYBSP_HEAP_SIZE)
+else ifeq ($(TOOLCHAIN),ARM)
+LDFLAGS+=--predefine="-D__STACK_SIZE=$(CYBSP_STACK_SIZE)" --predefine="-D__HEAP_SIZE=$(CYBSP_HEAP_SIZE)"
+else ifeq ($(TOOLCHAIN),IAR)
+LDFLAGS+=--config_def __STACK_SIZE=$(CYBSP_STACK_SIZE) --config_def __HEAP_SIZE=$(CYBSP_HEAP_SIZE)
+else ifeq ($(TOOLCHAIN),A_Clang)
+ASFLAGS+=-D__STACK_SIZE=$(CYBSP_STACK_SIZE) -D__HEAP_SIZE=$(CYBSP_HEAP_SIZE)
+endif
+
+# Size in bytes of the SRAM region at the end of the CM4 RAM that is shared with
+# the other core (cybsp_sharedmem.h). It is taken from the application RAM, so
+# it is only reserved when the IPC channel (CYBSP_IPC_CHANNEL) uses it. Override
+# in the application Makefile; the value is passed to the code and to the
+# linker of every toolchain.
+ifneq ($(filter CYBSP_IPC_CHANNEL,$(DEFINES)),)
+CYBSP_SHAREDMEM_SIZE?=0x8000
+else
+CYBSP_SHAREDMEM_SIZE?=0
+endif
+DEFINES+=CYBSP_SHAREDMEM_SIZE=$(CYBSP_SHAREDMEM_SIZE)
+
+ifeq ($(TOOLCHAIN),GCC_ARM)
+LDFLAGS+=-Wl,--defsym=__SHAREDMEM_SIZE=$(CYBSP_SHAREDMEM_SIZE)
+else ifeq ($(TOOLCHAIN),ARM)
+LDFLAGS+=--predefine="-D__SHAREDMEM_SIZE=$(CYBSP_SHAREDMEM_SIZE)"
+else ifeq ($(TOOLCHAIN),IAR)
+LDFLAGS+=--config_def __SHAREDMEM_SIZE=$(CYBSP_SHAREDMEM_SIZE)
+endif
+
+# The heap and stack painting in the startup code (CYBSP_MEM_USAGE) is
+# assembled, so the define is also passed to the assembler.
+ifneq ($(filter CYBSP_MEM_USAGE,$(DEFINES)),)
+ifeq ($(TOOLCHAIN),ARM)
+ASFLAGS+=--predefine "CYBSP_MEM_USAGE SETL {TRUE}"
+else
+ASFLAGS+=-DCYBSP_MEM_USAGE
+endif
+endif
+
+# The burst copy and fill of the GCC_ARM startup code (CYBSP_FAST_STARTUP) is
+# assembled as well.
+ifneq ($(filter CYBSP_FAST_STARTUP,$(DEFINES)),)
+ifeq ($(TOOLCHAIN),GCC_ARM)
+ASFLAGS+=-DCYBSP_FAST_STARTUP
+endif
+endif
+
+# With GCC_ARM, Reset_Handler classifies warm boots (CYBSP_WARM_BOOT) before
+# the RAM is initialized.
+ifneq ($(filter CYBSP_WARM_BOOT,$(DEFINES)),)
+ifeq ($(TOOLCHAIN),GCC_ARM)
+ASFLAGS+=-DCYBSP_WARM_BOOT
+endif
+endif
+
 ################################################################################
 # ALL ITEMS BELOW THIS POINT ARE AUTO GENERATED BY THE BSP ASSISTANT TOOL.
 # DO NOT MODIFY DIRECTLY. CHANGES SHOULD BE MADE THROUGH THE BSP ASSISTANT.
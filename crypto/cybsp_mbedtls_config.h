@@ -0,0 +1,63 @@
+/***********************************************************************************************//**
+ * \file cybsp_mbedtls_config.h
+ *
+ * \brief
+ * mbed TLS options that route AES, SHA and ECDSA to the PSoC 6 crypto block.
+ *
+ ***************************************************************************************************
+ * \copyright
+ * Copyright 2023 Cypress Semiconductor Corporation (an Infineon company) or
+ * an affiliate of Cypress Semiconductor Corporation
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ **************************************************************************************************/
+
+#pragma once
+
+/**
+ * \addtogroup group_bsp_crypto Crypto Acceleration
+ * \{
+ * The CY8C624A has a crypto block with AES, SHA and a vector unit for ECC. mbed TLS uses it
+ * through the alternate implementations of the cy-mbedtls-acceleration library. To enable them,
+ * add the library to the application and include this file from the mbed TLS user configuration:
+ *
+ *     DEFINES+=MBEDTLS_USER_CONFIG_FILE='"mbedtls_user_config.h"'
+ *
+ *     // mbedtls_user_config.h
+ *     #include "cybsp_mbedtls_config.h"
+ *
+ * AES-GCM uses the accelerated AES block cipher; GHASH stays in software. ECDHE key exchange and
+ * RSA are not offloaded.
+ *
+ * The library reserves the crypto block through the HAL for the lifetime of each mbed TLS
+ * context, so the BSP does not hold a permanent reservation that would make those reservations
+ * fail. Other HAL drivers that need the block (CRC, TRNG) share it through the same mechanism.
+ * \ref group_bsp_crypto_bench measures what the block achieves on this board.
+ */
+
+/** AES block cipher (ECB, CBC, CFB, CTR; the base of AES-GCM) */
+#define MBEDTLS_AES_ALT
+/** SHA-1 */
+#define MBEDTLS_SHA1_ALT
+/** SHA-224 and SHA-256 */
+#define MBEDTLS_SHA256_ALT
+/** SHA-384 and SHA-512 */
+#define MBEDTLS_SHA512_ALT
+/** ECDSA signature generation on NIST curves, P-256 for TLS */
+#define MBEDTLS_ECDSA_SIGN_ALT
+/** ECDSA signature verification on NIST curves, P-256 for TLS */
+#define MBEDTLS_ECDSA_VERIFY_ALT
+
+/** \} group_bsp_crypto */
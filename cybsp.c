@@ -34,6 +34,11 @@
 #include "cyhal_syspm.h"
 #endif
 
+#if defined(CYBSP_FAST_BOOT) && defined(COMPONENT_FREERTOS)
+#include "FreeRTOS.h"
+#include "task.h"
+#endif
+
 #if !defined (CY_CFG_PWR_SYS_IDLE_MODE) && defined(__MBED__)
 #include "mbed_power_mgmt.h"
 #endif
@@ -55,6 +60,13 @@ extern "C" {
     #define CYBSP_SYSCLK_PM_CALLBACK_ORDER  (255u)
 #endif
 
+// With fast wakeup the system resumes from the IMO instead of waiting for the PLL to relock
+#if defined(CYBSP_PM_FAST_WAKE)
+    #define CYBSP_SYSCLK_PM_CALLBACK_FUNC   (&cybsp_pm_fast_wake_callback)
+#else
+    #define CYBSP_SYSCLK_PM_CALLBACK_FUNC   (&Cy_SysClk_DeepSleepCallback)
+#endif
+
 //--------------------------------------------------------------------------------------------------
 // cybsp_register_sysclk_pm_callback
 //
@@ -68,33 +80,169 @@ static cy_rslt_t cybsp_register_sysclk_pm_callback(void)
     static cy_stc_syspm_callback_params_t cybsp_sysclk_pm_callback_param = { NULL, NULL };
     static cy_stc_syspm_callback_t        cybsp_sysclk_pm_callback       =
     {
-        .callback       = &Cy_SysClk_DeepSleepCallback,
+        .callback       = CYBSP_SYSCLK_PM_CALLBACK_FUNC,
         .type           = CY_SYSPM_DEEPSLEEP,
         .callbackParams = &cybsp_sysclk_pm_callback_param,
         .order          = CYBSP_SYSCLK_PM_CALLBACK_ORDER
     };
 
+    #if defined(CYBSP_PM_LATENCY)
+    // The SysClk callback is the first to run on wakeup and runs from the IMO until the PLL has
+    // relocked, so its exit time is the clock restore time.
+    static cybsp_pm_latency_probe_t cybsp_sysclk_pm_probe = { .runs_from_imo = true };
+    (void)cybsp_pm_latency_wrap(&cybsp_sysclk_pm_probe, &cybsp_sysclk_pm_callback, "SysClk");
+    #endif
+
     if (!Cy_SysPm_RegisterCallback(&cybsp_sysclk_pm_callback))
     {
         result = CYBSP_RSLT_ERR_SYSCLK_PM_CALLBACK;
     }
+
+    #if defined(CYBSP_PM_LATENCY)
+    if (CY_RSLT_SUCCESS == result)
+    {
+        result = cybsp_pm_latency_init();
+    }
+    #endif
+    return result;
+}
+
+
+#if defined(CYBSP_FAST_BOOT)
+// Head of the list of registered deferred initializers
+static cybsp_lazy_init_t* cybsp_lazy_init_list = NULL;
+
+//--------------------------------------------------------------------------------------------------
+// cybsp_lazy_init_register
+//--------------------------------------------------------------------------------------------------
+cy_rslt_t cybsp_lazy_init_register(cybsp_lazy_init_t* obj, cy_rslt_t (* init)(void))
+{
+    if ((NULL == obj) || (NULL == init))
+    {
+        return CYBSP_RSLT_ERR_LAZY_INIT_BAD_ARG;
+    }
+
+    cy_rslt_t result          = CY_RSLT_SUCCESS;
+    uint32_t  savedIntrStatus = Cy_SysLib_EnterCriticalSection();
+    for (cybsp_lazy_init_t* it = cybsp_lazy_init_list; NULL != it; it = it->next)
+    {
+        if (obj == it)
+        {
+            // Relinking a registered object would cut the list
+            result = CYBSP_RSLT_ERR_LAZY_INIT_BAD_ARG;
+        }
+    }
+    if (CY_RSLT_SUCCESS == result)
+    {
+        obj->init            = init;
+        obj->result          = CY_RSLT_SUCCESS;
+        obj->state           = CYBSP_LAZY_INIT_IDLE;
+        obj->next            = cybsp_lazy_init_list;
+        cybsp_lazy_init_list = obj;
+    }
+    Cy_SysLib_ExitCriticalSection(savedIntrStatus);
+
     return result;
 }
 
 
+//--------------------------------------------------------------------------------------------------
+// cybsp_lazy_init_run
+//--------------------------------------------------------------------------------------------------
+cy_rslt_t cybsp_lazy_init_run(cybsp_lazy_init_t* obj)
+{
+    CY_ASSERT(NULL != obj);
+
+    // Claim the initializer atomically so that it runs exactly once even if the idle hook and a
+    // first user race for it. The init function itself runs with interrupts enabled.
+    uint32_t savedIntrStatus = Cy_SysLib_EnterCriticalSection();
+    bool     run             = (CYBSP_LAZY_INIT_IDLE == obj->state);
+    if (run)
+    {
+        obj->state = CYBSP_LAZY_INIT_RUNNING;
+    }
+    Cy_SysLib_ExitCriticalSection(savedIntrStatus);
+
+    if (run)
+    {
+        obj->result = obj->init();
+        __DMB();
+        obj->state  = CYBSP_LAZY_INIT_DONE;
+    }
+    else
+    {
+        // Another context is running the initializer; its result is only valid once it is done
+        while (CYBSP_LAZY_INIT_DONE != obj->state)
+        {
+            if (0u != __get_IPSR())
+            {
+                // The preempted context cannot finish while an interrupt waits for it
+                return CYBSP_RSLT_ERR_LAZY_INIT_BUSY;
+            }
+            #if defined(COMPONENT_FREERTOS)
+            if (taskSCHEDULER_RUNNING == xTaskGetSchedulerState())
+            {
+                // Let a lower priority task that owns the initializer run
+                vTaskDelay(1u);
+            }
+            #endif
+        }
+    }
+    return obj->result;
+}
+
+
+//--------------------------------------------------------------------------------------------------
+// cybsp_lazy_init_run_all
+//--------------------------------------------------------------------------------------------------
+cy_rslt_t cybsp_lazy_init_run_all(void)
+{
+    cy_rslt_t result = CY_RSLT_SUCCESS;
+
+    // Initializers may be registered while the list is walked, so each link is read under the
+    // lock. Objects are never unlinked, which keeps a node valid while its init function runs.
+    uint32_t           savedIntrStatus = Cy_SysLib_EnterCriticalSection();
+    cybsp_lazy_init_t* obj             = cybsp_lazy_init_list;
+    Cy_SysLib_ExitCriticalSection(savedIntrStatus);
+
+    while (NULL != obj)
+    {
+        cy_rslt_t obj_result = cybsp_lazy_init_run(obj);
+        if (CY_RSLT_SUCCESS == result)
+        {
+            result = obj_result;
+        }
+
+        savedIntrStatus = Cy_SysLib_EnterCriticalSection();
+        obj             = obj->next;
+        Cy_SysLib_ExitCriticalSection(savedIntrStatus);
+    }
+    return result;
+}
+
+
+#endif // defined(CYBSP_FAST_BOOT)
+
 //--------------------------------------------------------------------------------------------------
 // cybsp_init
 //--------------------------------------------------------------------------------------------------
 cy_rslt_t cybsp_init(void)
 {
+    CYBSP_BOOT_PROFILE_END(CYBSP_BOOT_PHASE_RESET_TO_MAIN);
+    CYBSP_BOOT_PROFILE_BEGIN(CYBSP_BOOT_PHASE_BSP_INIT);
+
     // Setup hardware manager to track resource usage then initialize all system (clock/power) board
     // configuration
     #if defined(CY_USING_HAL)
+    CYBSP_BOOT_PROFILE_BEGIN(CYBSP_BOOT_PHASE_HWMGR_INIT);
     cy_rslt_t result = cyhal_hwmgr_init();
+    CYBSP_BOOT_PROFILE_END(CYBSP_BOOT_PHASE_HWMGR_INIT);
 
     if (CY_RSLT_SUCCESS == result)
     {
+        CYBSP_BOOT_PROFILE_BEGIN(CYBSP_BOOT_PHASE_SYSPM_INIT);
         result = cyhal_syspm_init();
+        CYBSP_BOOT_PROFILE_END(CYBSP_BOOT_PHASE_SYSPM_INIT);
     }
 
     #ifdef CY_CFG_PWR_VDDA_MV
@@ -108,14 +256,46 @@ cy_rslt_t cybsp_init(void)
     cy_rslt_t result = CY_RSLT_SUCCESS;
     #endif // if defined(CY_USING_HAL)
 
+    CYBSP_BOOT_PROFILE_BEGIN(CYBSP_BOOT_PHASE_CYCFG_INIT);
     init_cycfg_all();
+    CYBSP_BOOT_PROFILE_END(CYBSP_BOOT_PHASE_CYCFG_INIT);
 
     if (CY_RSLT_SUCCESS == result)
     {
+        CYBSP_BOOT_PROFILE_BEGIN(CYBSP_BOOT_PHASE_CLOCK_PROFILE);
+        result = cybsp_clock_profile_init();
+        CYBSP_BOOT_PROFILE_END(CYBSP_BOOT_PHASE_CLOCK_PROFILE);
+    }
+
+    #if defined(CYBSP_XIP)
+    // SMIF was brought up by SystemInit(), only the PM callback and reservations are left
+    if (CY_RSLT_SUCCESS == result)
+    {
+        result = cybsp_xip_init();
+    }
+    #endif
+
+    #if defined(CYBSP_POOL)
+    // The pool section is not initialized by the startup code
+    cybsp_pool_init();
+    #endif
+
+    if (CY_RSLT_SUCCESS == result)
+    {
+        CYBSP_BOOT_PROFILE_BEGIN(CYBSP_BOOT_PHASE_PM_CALLBACK);
         result = cybsp_register_sysclk_pm_callback();
+        CYBSP_BOOT_PROFILE_END(CYBSP_BOOT_PHASE_PM_CALLBACK);
     }
 
-    #if !defined(CY_CFG_PWR_SYS_IDLE_MODE)
+    #if defined(CYBSP_POWER_STATS)
+    if (CY_RSLT_SUCCESS == result)
+    {
+        result = cybsp_power_stats_init();
+    }
+    #endif
+
+    // With CYBSP_SLEEP_POLICY deep sleep is only locked while a client has work in flight
+    #if !defined(CY_CFG_PWR_SYS_IDLE_MODE) && !defined(CYBSP_SLEEP_POLICY)
     #ifdef __MBED__
     // Disable deep-sleep
     sleep_manager_lock_deep_sleep();
@@ -125,6 +305,7 @@ cy_rslt_t cybsp_init(void)
     #endif
 
     // Reserve resources used by NP
+    CYBSP_BOOT_PROFILE_BEGIN(CYBSP_BOOT_PHASE_NP_RESERVE);
     cyhal_resource_inst_t clock1 =
         { .type        = CYHAL_RSC_CLOCK, .block_num = CYHAL_CLOCK_BLOCK_PERIPHERAL_16BIT,
           .channel_num = 0 };
@@ -139,6 +320,18 @@ cy_rslt_t cybsp_init(void)
     {
         result = cyhal_hwmgr_reserve(&clock2);
     }
+    CYBSP_BOOT_PROFILE_END(CYBSP_BOOT_PHASE_NP_RESERVE);
+
+    #if defined(CYBSP_CLOCK_GATE)
+    // The NP dividers are excluded, everything else init_cycfg_all() enabled but left unconnected
+    // is stopped
+    if (CY_RSLT_SUCCESS == result)
+    {
+        (void)cybsp_clock_gate_unused();
+    }
+    #endif
+
+    CYBSP_BOOT_PROFILE_END(CYBSP_BOOT_PHASE_BSP_INIT);
 
     // CYHAL_HWMGR_RSLT_ERR_INUSE error code could be returned if any needed for BSP resource was
     // reserved by user previously. Please review the Device Configurator (design.modus) and the BSP
@@ -26,9 +26,33 @@
 
 #pragma once
 
+#include <stdbool.h>
 #include "cy_result.h"
 #include "cybsp_types.h"
 #include "cybsp_hw_config.h"
+#include "cybsp_boot_profile.h"
+#include "cybsp_clock_profile.h"
+#include "cybsp_pm_latency.h"
+#include "cybsp_sleep_policy.h"
+#include "cybsp_clock_gate.h"
+#include "cybsp_lptimer.h"
+#include "cybsp_power_stats.h"
+#include "cybsp_sharedmem.h"
+#include "cybsp_ramfunc.h"
+#include "cybsp_xip.h"
+#include "cybsp_warm_boot.h"
+#include "cybsp_xip_bench.h"
+#include "cybsp_flash_bench.h"
+#include "cybsp_logstore.h"
+#include "cybsp_mem_usage.h"
+#include "cybsp_pool.h"
+#include "cybsp_cpu_load.h"
+#include "cybsp_log.h"
+#include "cybsp_trace.h"
+#include "cybsp_crypto_bench.h"
+#include "cybsp_ipc_channel.h"
+#include "cybsp_ipc_job.h"
+#include "cybsp_perf_report.h"
 #if defined(COMPONENT_WICED_BLE) || defined(COMPONENT_WICED_DUALMODE)
 #include "cybsp_bt_config.h"
 #endif
@@ -47,6 +71,102 @@ extern "C" {
 #define CYBSP_RSLT_ERR_SYSCLK_PM_CALLBACK  \
     (CY_RSLT_CREATE(CY_RSLT_TYPE_ERROR, CY_RSLT_MODULE_ABSTRACTION_BSP, 0))
 
+/** A NULL object or function was passed to \ref cybsp_lazy_init_register */
+#define CYBSP_RSLT_ERR_LAZY_INIT_BAD_ARG  \
+    (CY_RSLT_CREATE(CY_RSLT_TYPE_ERROR, CY_RSLT_MODULE_ABSTRACTION_BSP, 1))
+
+/** The requested clock profile could not be applied (e.g. PLL did not lock or ULP mode) */
+#define CYBSP_RSLT_ERR_CLOCK_PROFILE  \
+    (CY_RSLT_CREATE(CY_RSLT_TYPE_ERROR, CY_RSLT_MODULE_ABSTRACTION_BSP, 2))
+
+/** A power management callback rejected the performance level change */
+#define CYBSP_RSLT_ERR_PERF_LEVEL_REJECTED  \
+    (CY_RSLT_CREATE(CY_RSLT_TYPE_ERROR, CY_RSLT_MODULE_ABSTRACTION_BSP, 3))
+
+/** Failed to register the deep sleep latency boundary callback */
+#define CYBSP_RSLT_ERR_PM_LATENCY_CALLBACK  \
+    (CY_RSLT_CREATE(CY_RSLT_TYPE_ERROR, CY_RSLT_MODULE_ABSTRACTION_BSP, 4))
+
+/** A NULL probe or callback was passed to \ref cybsp_pm_latency_wrap */
+#define CYBSP_RSLT_ERR_PM_LATENCY_BAD_ARG  \
+    (CY_RSLT_CREATE(CY_RSLT_TYPE_ERROR, CY_RSLT_MODULE_ABSTRACTION_BSP, 5))
+
+/** \ref cybsp_sleep_policy_unlock was called by a client that did not hold a lock */
+#define CYBSP_RSLT_ERR_SLEEP_POLICY_UNLOCK  \
+    (CY_RSLT_CREATE(CY_RSLT_TYPE_ERROR, CY_RSLT_MODULE_ABSTRACTION_BSP, 6))
+
+/** Invalid IPC channel configuration or no channel slot left */
+#define CYBSP_RSLT_ERR_IPC_CHANNEL_BAD_ARG  \
+    (CY_RSLT_CREATE(CY_RSLT_TYPE_ERROR, CY_RSLT_MODULE_ABSTRACTION_BSP, 7))
+
+/** The IPC channel ring has no free slot */
+#define CYBSP_RSLT_ERR_IPC_CHANNEL_FULL  \
+    (CY_RSLT_CREATE(CY_RSLT_TYPE_ERROR, CY_RSLT_MODULE_ABSTRACTION_BSP, 8))
+
+/** The QSPI flash could not be switched to memory mapped (XIP) mode */
+#define CYBSP_RSLT_ERR_XIP_INIT  \
+    (CY_RSLT_CREATE(CY_RSLT_TYPE_ERROR, CY_RSLT_MODULE_ABSTRACTION_BSP, 9))
+
+/** Invalid XIP cache profile or an address range outside the memory mapped QSPI flash */
+#define CYBSP_RSLT_ERR_XIP_BAD_ARG  \
+    (CY_RSLT_CREATE(CY_RSLT_TYPE_ERROR, CY_RSLT_MODULE_ABSTRACTION_BSP, 10))
+
+/** Invalid key, value or length passed to the log store */
+#define CYBSP_RSLT_ERR_LOGSTORE_BAD_ARG  \
+    (CY_RSLT_CREATE(CY_RSLT_TYPE_ERROR, CY_RSLT_MODULE_ABSTRACTION_BSP, 11))
+
+/** The live records of the log store fill every flash row */
+#define CYBSP_RSLT_ERR_LOGSTORE_FULL  \
+    (CY_RSLT_CREATE(CY_RSLT_TYPE_ERROR, CY_RSLT_MODULE_ABSTRACTION_BSP, 12))
+
+/** The key is not present in the log store */
+#define CYBSP_RSLT_ERR_LOGSTORE_NOT_FOUND  \
+    (CY_RSLT_CREATE(CY_RSLT_TYPE_ERROR, CY_RSLT_MODULE_ABSTRACTION_BSP, 13))
+
+/** A flash operation or the deep sleep callback registration of the log store failed */
+#define CYBSP_RSLT_ERR_LOGSTORE_FLASH  \
+    (CY_RSLT_CREATE(CY_RSLT_TYPE_ERROR, CY_RSLT_MODULE_ABSTRACTION_BSP, 14))
+
+/** The HCI UART baud rate cannot be generated from CLK_PERI within the tolerance */
+#define CYBSP_RSLT_ERR_BT_BAUD  \
+    (CY_RSLT_CREATE(CY_RSLT_TYPE_ERROR, CY_RSLT_MODULE_ABSTRACTION_BSP, 15))
+
+/** The log message was dropped because the log buffer is full */
+#define CYBSP_RSLT_ERR_LOG_FULL  \
+    (CY_RSLT_CREATE(CY_RSLT_TYPE_ERROR, CY_RSLT_MODULE_ABSTRACTION_BSP, 16))
+
+/** The SWO bit rate cannot be generated from the trace clock */
+#define CYBSP_RSLT_ERR_TRACE_INIT  \
+    (CY_RSLT_CREATE(CY_RSLT_TYPE_ERROR, CY_RSLT_MODULE_ABSTRACTION_BSP, 17))
+
+/** A crypto benchmark operation failed or produced a wrong result */
+#define CYBSP_RSLT_ERR_CRYPTO_BENCH  \
+    (CY_RSLT_CREATE(CY_RSLT_TYPE_ERROR, CY_RSLT_MODULE_ABSTRACTION_BSP, 18))
+
+/** The worker has no handler for the type of the job */
+#define CYBSP_RSLT_ERR_IPC_JOB_TYPE  \
+    (CY_RSLT_CREATE(CY_RSLT_TYPE_ERROR, CY_RSLT_MODULE_ABSTRACTION_BSP, 19))
+
+/** The clock divider does not exist or has no user to release */
+#define CYBSP_RSLT_ERR_CLOCK_GATE  \
+    (CY_RSLT_CREATE(CY_RSLT_TYPE_ERROR, CY_RSLT_MODULE_ABSTRACTION_BSP, 20))
+
+/** The power accounting callbacks could not be registered */
+#define CYBSP_RSLT_ERR_POWER_STATS  \
+    (CY_RSLT_CREATE(CY_RSLT_TYPE_ERROR, CY_RSLT_MODULE_ABSTRACTION_BSP, 21))
+
+/** A flash operation measured by the flash benchmark failed */
+#define CYBSP_RSLT_ERR_FLASH_BENCH  \
+    (CY_RSLT_CREATE(CY_RSLT_TYPE_ERROR, CY_RSLT_MODULE_ABSTRACTION_BSP, 22))
+
+/** \ref cybsp_lazy_init_run was called from an interrupt while the initializer was running */
+#define CYBSP_RSLT_ERR_LAZY_INIT_BUSY  \
+    (CY_RSLT_CREATE(CY_RSLT_TYPE_ERROR, CY_RSLT_MODULE_ABSTRACTION_BSP, 23))
+
+/** The performance level would retime the network processor image running on the CM0+ */
+#define CYBSP_RSLT_ERR_PERF_LEVEL_NP  \
+    (CY_RSLT_CREATE(CY_RSLT_TYPE_ERROR, CY_RSLT_MODULE_ABSTRACTION_BSP, 24))
+
 /** \} group_bsp_errors */
 
 /**
@@ -76,6 +196,57 @@ cy_rslt_t cybsp_init(void);
 cy_rslt_t cybsp_register_custom_sysclk_pm_callback(void);
 #endif // defined(CYBSP_CUSTOM_SYSCLK_PM_CALLBACK)
 
+#if defined(CYBSP_FAST_BOOT)
+/** State of a deferred initializer */
+typedef enum
+{
+    CYBSP_LAZY_INIT_IDLE,       /**< Registered, the init function has not been started */
+    CYBSP_LAZY_INIT_RUNNING,    /**< The init function is running in some context */
+    CYBSP_LAZY_INIT_DONE        /**< The init function has returned, the result is valid */
+} cybsp_lazy_init_state_t;
+
+/**
+ * Deferred initializer used in fast-boot mode. The object is owned by the caller and must stay
+ * valid for the lifetime of the application. The fields are managed by the BSP.
+ */
+typedef struct cybsp_lazy_init
+{
+    cy_rslt_t (* init)(void);               /**< Function that performs the initialization */
+    struct cybsp_lazy_init* next;           /**< Next registered initializer */
+    cy_rslt_t result;                       /**< Result of the init function once it is done */
+    volatile cybsp_lazy_init_state_t state; /**< Progress of the init function */
+} cybsp_lazy_init_t;
+
+/**
+ * \brief Registers a function to run on first use or from the idle hook instead of at boot.
+ * Only available when CYBSP_FAST_BOOT is defined.
+ * \param obj  Initializer object to register
+ * \param init Function that performs the initialization
+ * \returns CY_RSLT_SUCCESS if the initializer was registered, CYBSP_RSLT_ERR_LAZY_INIT_BAD_ARG
+ *          if either argument is NULL or the object is already registered.
+ */
+cy_rslt_t cybsp_lazy_init_register(cybsp_lazy_init_t* obj, cy_rslt_t (* init)(void));
+
+/**
+ * \brief Runs a deferred initializer if it has not run yet.
+ * Call this before first using the resource the initializer sets up. Calling it again after the
+ * initializer has run is cheap and returns the stored result. If another context is running the
+ * initializer, the call waits until it is done (yielding with vTaskDelay() once the FreeRTOS
+ * scheduler runs); from an interrupt it returns CYBSP_RSLT_ERR_LAZY_INIT_BUSY instead.
+ * \param obj Initializer to run
+ * \returns The result of the init function, or CYBSP_RSLT_ERR_LAZY_INIT_BUSY
+ */
+cy_rslt_t cybsp_lazy_init_run(cybsp_lazy_init_t* obj);
+
+/**
+ * \brief Runs every registered initializer that has not run yet.
+ * Intended to be called from the RTOS idle hook or the application main loop once the
+ * time-critical work after boot is done.
+ * \returns CY_RSLT_SUCCESS if all initializers succeeded, otherwise the first error
+ */
+cy_rslt_t cybsp_lazy_init_run_all(void);
+#endif // defined(CYBSP_FAST_BOOT)
+
 /** \} group_bsp_functions */
 
 #ifdef __cplusplus
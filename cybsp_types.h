@@ -40,8 +40,11 @@ extern "C" {
 #define CYBSP_WIFI_INTERFACE_TYPE (CYBSP_SDIO_INTERFACE)
 #elif defined(COMPONENT_WIFI_INTERFACE_SPI)
 #define CYBSP_WIFI_INTERFACE_TYPE (CYBSP_SPI_INTERFACE)
-#elif defined(COMPONENT_WIFI_INTERFACE_M2M)
-#define CYBSP_WIFI_INTERFACE_TYPE (CYBSP_M2M_INTERFACE)
+#endif
+
+/* The CYW43012 on this board is a discrete chip attached over SDIO */
+#if defined(COMPONENT_WIFI_INTERFACE_M2M)
+#error "The M2M Wi-Fi interface is not available on CYSBSYSKIT-01, use WIFI_INTERFACE_SDIO"
 #endif
 /** \endcond */
 
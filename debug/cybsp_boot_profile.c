@@ -0,0 +1,181 @@
+/***********************************************************************************************//**
+ * \file cybsp_boot_profile.c
+ *
+ * Description:
+ * Records the duration of each phase of SystemInit() and cybsp_init() using the DWT cycle counter.
+ *
+ ***************************************************************************************************
+ * \copyright
+ * Copyright 2023 Cypress Semiconductor Corporation (an Infineon company) or
+ * an affiliate of Cypress Semiconductor Corporation
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ **************************************************************************************************/
+
+#if defined(CYBSP_BOOT_PROFILE)
+
+#include <stddef.h>
+#include "cy_device_headers.h"
+#include "cy_syslib.h"
+#include "system_psoc6.h"
+#include "cybsp_boot_profile.h"
+
+#if defined(__cplusplus)
+extern "C" {
+#endif
+
+// Marks the table as initialized. The table lives in .noinit because it is reset from
+// Cy_OnResetUser(), before the data sections are initialized.
+#define CYBSP_BOOT_PROFILE_MAGIC    (0x42505246u)
+
+typedef struct
+{
+    uint32_t                   magic;
+    uint32_t                   started;
+    uint32_t                   finished;
+    cybsp_boot_profile_entry_t entries[CYBSP_BOOT_PHASE_COUNT];
+} cybsp_boot_profile_table_t;
+
+static CY_NOINIT cybsp_boot_profile_table_t cybsp_boot_profile_table;
+
+static const char* const cybsp_boot_profile_names[CYBSP_BOOT_PHASE_COUNT] =
+{
+    "SystemInit",
+    "Cy_PDL_Init",
+    "WDT disable",
+    "IPC init",
+    "Cy_Flash_Init",
+    "XIP init",
+    "cybsp_init",
+    "cyhal_hwmgr_init",
+    "cyhal_syspm_init",
+    "init_cycfg_all",
+    "Clock profile",
+    "PM callback",
+    "NP reservations",
+    "Reset to main"
+};
+
+
+//--------------------------------------------------------------------------------------------------
+// Cy_OnResetUser
+//
+// Replaces the weak function of the startup code, which calls it first in Reset_Handler. Only the
+// core registers and the .noinit table may be used here.
+//--------------------------------------------------------------------------------------------------
+void Cy_OnResetUser(void)
+{
+    // Start the cycle counter from zero and reset the table
+    CoreDebug->DEMCR |= CoreDebug_DEMCR_TRCENA_Msk;
+    DWT->CYCCNT       = 0u;
+    DWT->CTRL        |= DWT_CTRL_CYCCNTENA_Msk;
+
+    cybsp_boot_profile_table.magic    = CYBSP_BOOT_PROFILE_MAGIC;
+    cybsp_boot_profile_table.started  = 0u;
+    cybsp_boot_profile_table.finished = 0u;
+    cybsp_boot_profile_begin(CYBSP_BOOT_PHASE_RESET_TO_MAIN);
+}
+
+
+//--------------------------------------------------------------------------------------------------
+// cybsp_boot_profile_begin
+//--------------------------------------------------------------------------------------------------
+void cybsp_boot_profile_begin(cybsp_boot_phase_t phase)
+{
+    if ((CYBSP_BOOT_PROFILE_MAGIC == cybsp_boot_profile_table.magic) &&
+        (phase < CYBSP_BOOT_PHASE_COUNT))
+    {
+        cybsp_boot_profile_table.entries[phase].start_cycles = DWT->CYCCNT;
+        cybsp_boot_profile_table.started                    |= (1UL << (uint32_t)phase);
+    }
+}
+
+
+//--------------------------------------------------------------------------------------------------
+// cybsp_boot_profile_end
+//--------------------------------------------------------------------------------------------------
+void cybsp_boot_profile_end(cybsp_boot_phase_t phase)
+{
+    uint32_t now = DWT->CYCCNT;
+
+    if ((CYBSP_BOOT_PROFILE_MAGIC == cybsp_boot_profile_table.magic) &&
+        (phase < CYBSP_BOOT_PHASE_COUNT))
+    {
+        cybsp_boot_profile_table.entries[phase].end_cycles = now;
+        cybsp_boot_profile_table.entries[phase].clock_hz   = SystemCoreClock;
+        cybsp_boot_profile_table.finished                 |= (1UL << (uint32_t)phase);
+    }
+}
+
+
+//--------------------------------------------------------------------------------------------------
+// cybsp_boot_profile_now
+//--------------------------------------------------------------------------------------------------
+uint32_t cybsp_boot_profile_now(void)
+{
+    return DWT->CYCCNT;
+}
+
+
+//--------------------------------------------------------------------------------------------------
+// cybsp_boot_profile_get
+//--------------------------------------------------------------------------------------------------
+const cybsp_boot_profile_entry_t* cybsp_boot_profile_get(cybsp_boot_phase_t phase)
+{
+    const cybsp_boot_profile_entry_t* entry = NULL;
+
+    if ((CYBSP_BOOT_PROFILE_MAGIC == cybsp_boot_profile_table.magic) &&
+        (phase < CYBSP_BOOT_PHASE_COUNT))
+    {
+        uint32_t mask = (1UL << (uint32_t)phase);
+        if (0u != (cybsp_boot_profile_table.started & cybsp_boot_profile_table.finished & mask))
+        {
+            entry = &cybsp_boot_profile_table.entries[phase];
+        }
+    }
+    return entry;
+}
+
+
+//--------------------------------------------------------------------------------------------------
+// cybsp_boot_profile_dump
+//--------------------------------------------------------------------------------------------------
+void cybsp_boot_profile_dump(cybsp_boot_profile_print_t print_fn)
+{
+    if (NULL != print_fn)
+    {
+        for (uint32_t i = 0u; i < (uint32_t)CYBSP_BOOT_PHASE_COUNT; i++)
+        {
+            const cybsp_boot_profile_entry_t* entry = cybsp_boot_profile_get((cybsp_boot_phase_t)i);
+            if (NULL != entry)
+            {
+                uint32_t cycles = entry->end_cycles - entry->start_cycles;
+                uint32_t mhz    = CY_SYSLIB_DIV_ROUNDUP(entry->clock_hz, 1000000UL);
+                (void)print_fn("%-18s start %10lu cyc  duration %10lu cyc  %8lu us\r\n",
+                               cybsp_boot_profile_names[i],
+                               (unsigned long)entry->start_cycles,
+                               (unsigned long)cycles,
+                               (unsigned long)((0u != mhz) ? (cycles / mhz) : 0u));
+            }
+        }
+    }
+}
+
+
+#if defined(__cplusplus)
+}
+#endif
+
+#endif // defined(CYBSP_BOOT_PROFILE)
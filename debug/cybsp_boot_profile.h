@@ -0,0 +1,134 @@
+/***********************************************************************************************//**
+ * \file cybsp_boot_profile.h
+ *
+ * \brief
+ * Optional instrumentation of the startup sequence (SystemInit() and cybsp_init()).
+ *
+ ***************************************************************************************************
+ * \copyright
+ * Copyright 2023 Cypress Semiconductor Corporation (an Infineon company) or
+ * an affiliate of Cypress Semiconductor Corporation
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ **************************************************************************************************/
+
+#pragma once
+
+#include <stdint.h>
+
+#if defined(__cplusplus)
+extern "C" {
+#endif
+
+/**
+ * \addtogroup group_bsp_boot_profile Boot Profiler
+ * \{
+ * When CYBSP_BOOT_PROFILE is defined, every phase of SystemInit() and cybsp_init() is timestamped
+ * with the DWT cycle counter and recorded in a RAM table. The counter is started from
+ * Cy_OnResetUser(), the first function called by Reset_Handler, so all timestamps are relative to
+ * the reset, and \ref CYBSP_BOOT_PHASE_RESET_TO_MAIN covers the startup code up to
+ * \ref cybsp_init, which is expected to be the first call in main(). When the define is not set
+ * the instrumentation macros expand to nothing.
+ *
+ * \note The BSP provides Cy_OnResetUser() in this configuration, so the application must not
+ * define its own. With GCC_ARM and CYBSP_MEM_USAGE, the stack painting in Reset_Handler runs
+ * before it and is not included.
+ */
+
+/** Startup phases recorded by the boot profiler */
+typedef enum
+{
+    CYBSP_BOOT_PHASE_SYSTEM_INIT,   /**< SystemInit() as a whole */
+    CYBSP_BOOT_PHASE_PDL_INIT,      /**< Cy_PDL_Init() */
+    CYBSP_BOOT_PHASE_WDT_DISABLE,   /**< FLL restore and WDT unlock/disable (single core only) */
+    CYBSP_BOOT_PHASE_IPC_INIT,      /**< IPC semaphore and system pipe setup */
+    CYBSP_BOOT_PHASE_FLASH_INIT,    /**< Cy_Flash_Init() */
+    CYBSP_BOOT_PHASE_XIP_INIT,      /**< SMIF memory mapped mode setup (CYBSP_XIP only) */
+    CYBSP_BOOT_PHASE_BSP_INIT,      /**< cybsp_init() as a whole */
+    CYBSP_BOOT_PHASE_HWMGR_INIT,    /**< cyhal_hwmgr_init() */
+    CYBSP_BOOT_PHASE_SYSPM_INIT,    /**< cyhal_syspm_init() */
+    CYBSP_BOOT_PHASE_CYCFG_INIT,    /**< init_cycfg_all() */
+    CYBSP_BOOT_PHASE_CLOCK_PROFILE, /**< Switch to the build-time selected clock profile */
+    CYBSP_BOOT_PHASE_PM_CALLBACK,   /**< SysClk power management callback registration */
+    CYBSP_BOOT_PHASE_NP_RESERVE,    /**< Reservation of the peripheral clocks used by the NP */
+    CYBSP_BOOT_PHASE_RESET_TO_MAIN, /**< From Reset_Handler to the start of cybsp_init() */
+    CYBSP_BOOT_PHASE_COUNT          /**< Number of phases, not a valid phase */
+} cybsp_boot_phase_t;
+
+/** A single entry of the boot profile table */
+typedef struct
+{
+    uint32_t start_cycles;  /**< DWT cycle count when the phase started */
+    uint32_t end_cycles;    /**< DWT cycle count when the phase ended */
+    uint32_t clock_hz;      /**< SystemCoreClock when the phase ended */
+} cybsp_boot_profile_entry_t;
+
+/** printf compatible function used to dump the boot profile table */
+typedef int (*cybsp_boot_profile_print_t)(const char* format, ...);
+
+#if defined(CYBSP_BOOT_PROFILE)
+
+/** Marks the start of a boot phase. */
+#define CYBSP_BOOT_PROFILE_BEGIN(phase)     cybsp_boot_profile_begin(phase)
+/** Marks the end of a boot phase. */
+#define CYBSP_BOOT_PROFILE_END(phase)       cybsp_boot_profile_end(phase)
+
+/**
+ * \brief Records the start of a boot phase.
+ * \param phase The phase that is starting
+ */
+void cybsp_boot_profile_begin(cybsp_boot_phase_t phase);
+
+/**
+ * \brief Records the end of a boot phase.
+ * \param phase The phase that is ending
+ */
+void cybsp_boot_profile_end(cybsp_boot_phase_t phase);
+
+/**
+ * \brief Returns the number of CPU cycles elapsed since the reset.
+ * This can be used by the application to timestamp its own milestones (e.g. the first sent
+ * packet) on the same time base as the boot profile table.
+ * \returns The current DWT cycle count
+ */
+uint32_t cybsp_boot_profile_now(void);
+
+/**
+ * \brief Returns the recorded entry for a boot phase.
+ * \param phase The phase to look up
+ * \returns Pointer to the entry, or NULL if the phase was not (completely) recorded
+ */
+const cybsp_boot_profile_entry_t* cybsp_boot_profile_get(cybsp_boot_phase_t phase);
+
+/**
+ * \brief Prints every recorded boot phase with its start time and duration.
+ * Cycle counts are converted to microseconds using the core clock at the end of each phase, so
+ * phases that change the clock frequency (e.g. init_cycfg_all()) are only approximate in us.
+ * \param print_fn printf compatible function used for the output
+ */
+void cybsp_boot_profile_dump(cybsp_boot_profile_print_t print_fn);
+
+#else // if defined(CYBSP_BOOT_PROFILE)
+
+#define CYBSP_BOOT_PROFILE_BEGIN(phase)
+#define CYBSP_BOOT_PROFILE_END(phase)
+
+#endif // defined(CYBSP_BOOT_PROFILE)
+
+/** \} group_bsp_boot_profile */
+
+#ifdef __cplusplus
+}
+#endif // __cplusplus
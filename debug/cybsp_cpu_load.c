@@ -0,0 +1,126 @@
+/***********************************************************************************************//**
+ * \file cybsp_cpu_load.c
+ *
+ * Description:
+ * Measures the CM4 load from the DWT cycle counter against the LPTIMER.
+ *
+ ***************************************************************************************************
+ * \copyright
+ * Copyright 2023 Cypress Semiconductor Corporation (an Infineon company) or
+ * an affiliate of Cypress Semiconductor Corporation
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ **************************************************************************************************/
+
+#if defined(CYBSP_CPU_LOAD)
+
+#include <stddef.h>
+#include "cy_device_headers.h"
+#include "cy_syslib.h"
+#include "system_psoc6.h"
+#include "cybsp.h"
+
+#if defined(__cplusplus)
+extern "C" {
+#endif
+
+// Shared LPTIMER tick rate, the LFCLK frequency reported by the HAL
+static uint32_t cybsp_cpu_load_timer_hz;
+
+//--------------------------------------------------------------------------------------------------
+// cybsp_cpu_load_init
+//--------------------------------------------------------------------------------------------------
+cy_rslt_t cybsp_cpu_load_init(void)
+{
+    cy_rslt_t result = cybsp_lptimer_init();
+    if (CY_RSLT_SUCCESS == result)
+    {
+        cybsp_cpu_load_timer_hz = cybsp_lptimer_get_frequency();
+
+        CoreDebug->DEMCR |= CoreDebug_DEMCR_TRCENA_Msk;
+        DWT->CTRL        |= DWT_CTRL_CYCCNTENA_Msk;
+    }
+    return result;
+}
+
+
+//--------------------------------------------------------------------------------------------------
+// cybsp_cpu_load_start
+//--------------------------------------------------------------------------------------------------
+void cybsp_cpu_load_start(cybsp_cpu_load_window_t* window)
+{
+    CY_ASSERT(NULL != window);
+
+    uint32_t savedIntrStatus = Cy_SysLib_EnterCriticalSection();
+    window->start_ticks  = cybsp_lptimer_read();
+    window->start_cycles = DWT->CYCCNT;
+    Cy_SysLib_ExitCriticalSection(savedIntrStatus);
+}
+
+
+//--------------------------------------------------------------------------------------------------
+// cybsp_cpu_load_stop
+//--------------------------------------------------------------------------------------------------
+void cybsp_cpu_load_stop(const cybsp_cpu_load_window_t* window, uint64_t bytes,
+                         cybsp_cpu_load_result_t* result)
+{
+    CY_ASSERT((NULL != window) && (NULL != result));
+
+    uint32_t savedIntrStatus = Cy_SysLib_EnterCriticalSection();
+    uint32_t ticks           = cybsp_lptimer_read() - window->start_ticks;
+    uint32_t cycles          = DWT->CYCCNT - window->start_cycles;
+    Cy_SysLib_ExitCriticalSection(savedIntrStatus);
+
+    uint64_t elapsed_us = ((uint64_t)ticks * 1000000u) / cybsp_cpu_load_timer_hz;
+    uint64_t busy_us    = ((uint64_t)cycles * 1000000u) / SystemCoreClock;
+
+    // The LPTIMER resolution is about 30 us, keep the load within 100% for very short windows
+    if (busy_us > elapsed_us)
+    {
+        busy_us = elapsed_us;
+    }
+
+    result->elapsed_us    = (uint32_t)elapsed_us;
+    result->busy_us       = (uint32_t)busy_us;
+    result->load_permille = (0u != elapsed_us) ? (uint32_t)((busy_us * 1000u) / elapsed_us) : 0u;
+    // bits per millisecond are kbit/s
+    result->kbit_s        = (0u != elapsed_us) ? (uint32_t)((bytes * 8000u) / elapsed_us) : 0u;
+}
+
+
+//--------------------------------------------------------------------------------------------------
+// cybsp_cpu_load_dump
+//--------------------------------------------------------------------------------------------------
+void cybsp_cpu_load_dump(const char* label, const cybsp_cpu_load_result_t* result,
+                         cybsp_cpu_load_print_t print_fn)
+{
+    if ((NULL != result) && (NULL != print_fn))
+    {
+        (void)print_fn("%-10s %4lu.%03lu s  %6lu kbit/s  CPU %3lu.%lu%%\r\n",
+                       (NULL != label) ? label : "",
+                       (unsigned long)(result->elapsed_us / 1000000u),
+                       (unsigned long)((result->elapsed_us / 1000u) % 1000u),
+                       (unsigned long)result->kbit_s,
+                       (unsigned long)(result->load_permille / 10u),
+                       (unsigned long)(result->load_permille % 10u));
+    }
+}
+
+
+#if defined(__cplusplus)
+}
+#endif
+
+#endif // defined(CYBSP_CPU_LOAD)
@@ -0,0 +1,113 @@
+/***********************************************************************************************//**
+ * \file cybsp_cpu_load.h
+ *
+ * \brief
+ * CPU load and throughput measurement over a time window, for network benchmarks.
+ *
+ ***************************************************************************************************
+ * \copyright
+ * Copyright 2023 Cypress Semiconductor Corporation (an Infineon company) or
+ * an affiliate of Cypress Semiconductor Corporation
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ **************************************************************************************************/
+
+#pragma once
+
+#include <stdint.h>
+#include "cy_result.h"
+#include "cybsp_lptimer.h"
+
+#if defined(__cplusplus)
+extern "C" {
+#endif
+
+/**
+ * \addtogroup group_bsp_cpu_load CPU Load
+ * \{
+ * When CYBSP_CPU_LOAD is defined, the BSP can report the CM4 load and the throughput of a
+ * transfer, for example an iperf TCP or UDP run over the SCL Wi-Fi link, over a measurement
+ * window. The load is derived from the DWT cycle counter, which stops while the CPU sleeps, and
+ * the elapsed time from the shared LPTIMER (\ref group_bsp_lptimer) on the 32.768 kHz WCO, which
+ * keeps running in Sleep and Deep Sleep. The idle loop must therefore put the CPU to sleep, as
+ * \ref cybsp_sleep_policy_idle and the FreeRTOS idle task do; a busy-waiting idle loop shows up as
+ * 100% load.
+ *
+ * A window must be shorter than 2^32 CPU cycles (about 42 s at 100 MHz) and the CM4 clock must not
+ * change during the window.
+ *
+ * \note On this board the SDIO bus to the CYW43012 is driven by the network processor image on
+ * the CM0+, so the SDIO clock and transfer mode are set by that image, not by the CM4 BSP.
+ */
+
+#if defined(CYBSP_CPU_LOAD)
+
+/** A measurement window, see \ref cybsp_cpu_load_start */
+typedef struct
+{
+    uint32_t start_ticks;       /**< LPTIMER count at the start */
+    uint32_t start_cycles;      /**< DWT cycle count at the start */
+} cybsp_cpu_load_window_t;
+
+/** Result of a measurement window, see \ref cybsp_cpu_load_stop */
+typedef struct
+{
+    uint32_t elapsed_us;        /**< Length of the window */
+    uint32_t busy_us;           /**< Time the CPU was not sleeping */
+    uint32_t load_permille;     /**< busy_us relative to elapsed_us, in 1/1000 */
+    uint32_t kbit_s;            /**< Throughput of the bytes passed to \ref cybsp_cpu_load_stop */
+} cybsp_cpu_load_result_t;
+
+/** printf compatible function used to print the result */
+typedef int (*cybsp_cpu_load_print_t)(const char* format, ...);
+
+/**
+ * \brief Reserves the shared LPTIMER and enables the cycle counter. Call once before the first
+ * window.
+ * \returns CY_RSLT_SUCCESS, or the error from \ref cybsp_lptimer_init if no LPTIMER is free
+ */
+cy_rslt_t cybsp_cpu_load_init(void);
+
+/**
+ * \brief Starts a measurement window.
+ * \param window Window to start
+ */
+void cybsp_cpu_load_start(cybsp_cpu_load_window_t* window);
+
+/**
+ * \brief Ends a measurement window.
+ * \param window Window started by \ref cybsp_cpu_load_start
+ * \param bytes  Number of bytes transferred during the window, 0 if not applicable
+ * \param result Filled with the load and throughput
+ */
+void cybsp_cpu_load_stop(const cybsp_cpu_load_window_t* window, uint64_t bytes,
+                         cybsp_cpu_load_result_t* result);
+
+/**
+ * \brief Prints a result in the style of an iperf interval report.
+ * \param label    Name of the measurement, such as "TCP TX"
+ * \param result   Result of \ref cybsp_cpu_load_stop
+ * \param print_fn printf compatible function used for the output
+ */
+void cybsp_cpu_load_dump(const char* label, const cybsp_cpu_load_result_t* result,
+                         cybsp_cpu_load_print_t print_fn);
+
+#endif // defined(CYBSP_CPU_LOAD)
+
+/** \} group_bsp_cpu_load */
+
+#ifdef __cplusplus
+}
+#endif // __cplusplus
@@ -0,0 +1,209 @@
+/***********************************************************************************************//**
+ * \file cybsp_crypto_bench.c
+ *
+ * Description:
+ * Measures SHA-256, AES-128-CTR and ECDSA P-256 on the crypto block using the DWT cycle counter.
+ *
+ ***************************************************************************************************
+ * \copyright
+ * Copyright 2023 Cypress Semiconductor Corporation (an Infineon company) or
+ * an affiliate of Cypress Semiconductor Corporation
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ **************************************************************************************************/
+
+#if defined(CYBSP_CRYPTO_BENCH)
+
+#include <stdbool.h>
+#include <string.h>
+#include "cy_device_headers.h"
+#include "cy_crypto_core.h"
+#include "system_psoc6.h"
+#include "cyhal_crypto_common.h"
+#include "cybsp.h"
+#include "cybsp_crypto_bench.h"
+
+#if defined(__cplusplus)
+extern "C" {
+#endif
+
+#define CYBSP_CRYPTO_BENCH_KEY_SIZE     CY_CRYPTO_BYTE_SIZE_OF_BITS(CY_CRYPTO_ECC_P256_SIZE)
+
+// Fixed P-256 private key and nonce (little-endian, far below the group order)
+static const uint8_t cybsp_crypto_bench_priv[CYBSP_CRYPTO_BENCH_KEY_SIZE] =
+{
+    0x01u, 0x02u, 0x03u, 0x04u, 0x05u, 0x06u, 0x07u, 0x08u, 0x09u, 0x0Au, 0x0Bu, 0x0Cu, 0x0Du,
+    0x0Eu, 0x0Fu, 0x10u, 0x11u, 0x12u, 0x13u, 0x14u, 0x15u, 0x16u, 0x17u, 0x18u, 0x19u, 0x1Au,
+    0x1Bu, 0x1Cu, 0x1Du, 0x1Eu, 0x1Fu, 0x20u
+};
+static const uint8_t cybsp_crypto_bench_nonce[CYBSP_CRYPTO_BENCH_KEY_SIZE] =
+{
+    0x20u, 0x1Fu, 0x1Eu, 0x1Du, 0x1Cu, 0x1Bu, 0x1Au, 0x19u, 0x18u, 0x17u, 0x16u, 0x15u, 0x14u,
+    0x13u, 0x12u, 0x11u, 0x10u, 0x0Fu, 0x0Eu, 0x0Du, 0x0Cu, 0x0Bu, 0x0Au, 0x09u, 0x08u, 0x07u,
+    0x06u, 0x05u, 0x04u, 0x03u, 0x02u, 0x01u
+};
+static const uint8_t cybsp_crypto_bench_aes_key[CY_CRYPTO_AES_128_KEY_SIZE] =
+{
+    0x2Bu, 0x7Eu, 0x15u, 0x16u, 0x28u, 0xAEu, 0xD2u, 0xA6u,
+    0xABu, 0xF7u, 0x15u, 0x88u, 0x09u, 0xCFu, 0x4Fu, 0x3Cu
+};
+
+//--------------------------------------------------------------------------------------------------
+// cybsp_crypto_bench_kbyte_s
+//--------------------------------------------------------------------------------------------------
+static uint32_t cybsp_crypto_bench_kbyte_s(uint32_t bytes, uint32_t cycles)
+{
+    return (0u != cycles)
+        ? (uint32_t)(((uint64_t)bytes * (SystemCoreClock / 1000u)) / cycles)
+        : 0u;
+}
+
+
+//--------------------------------------------------------------------------------------------------
+// cybsp_crypto_bench_us
+//--------------------------------------------------------------------------------------------------
+static uint32_t cybsp_crypto_bench_us(uint32_t cycles)
+{
+    return (uint32_t)(((uint64_t)cycles * 1000000u) / SystemCoreClock);
+}
+
+
+//--------------------------------------------------------------------------------------------------
+// cybsp_crypto_bench_passes
+//--------------------------------------------------------------------------------------------------
+static cy_rslt_t cybsp_crypto_bench_passes(CRYPTO_Type* base, uint8_t* buffer, uint32_t length,
+                                           cybsp_crypto_bench_result_t* result)
+{
+    uint8_t  digest[CY_CRYPTO_SHA256_DIGEST_SIZE];
+    uint32_t start = DWT->CYCCNT;
+    bool     ok    = (CY_CRYPTO_SUCCESS ==
+                      Cy_Crypto_Core_Sha(base, buffer, length, digest, CY_CRYPTO_MODE_SHA256));
+    result->sha256_kbyte_s = cybsp_crypto_bench_kbyte_s(length, DWT->CYCCNT - start);
+
+    cy_stc_crypto_aes_state_t aes_state;
+    uint8_t                   counter[CY_CRYPTO_AES_BLOCK_SIZE] = { 0u };
+    uint8_t                   stream[CY_CRYPTO_AES_BLOCK_SIZE];
+    uint32_t                  offset = 0u;
+    if (ok)
+    {
+        ok = (CY_CRYPTO_SUCCESS == Cy_Crypto_Core_Aes_Init(base, cybsp_crypto_bench_aes_key,
+                                                           CY_CRYPTO_KEY_AES_128, &aes_state));
+    }
+    if (ok)
+    {
+        start = DWT->CYCCNT;
+        ok    = (CY_CRYPTO_SUCCESS == Cy_Crypto_Core_Aes_Ctr(base, &aes_state, length, &offset,
+                                                             counter, stream, buffer, buffer));
+        result->aes128_ctr_kbyte_s = cybsp_crypto_bench_kbyte_s(length, DWT->CYCCNT - start);
+        (void)Cy_Crypto_Core_Aes_Free(base, &aes_state);
+    }
+
+    // The ECDSA pass signs the SHA-256 digest of the buffer
+    uint8_t               pub_x[CYBSP_CRYPTO_BENCH_KEY_SIZE];
+    uint8_t               pub_y[CYBSP_CRYPTO_BENCH_KEY_SIZE];
+    uint8_t               sig[2u * CYBSP_CRYPTO_BENCH_KEY_SIZE];
+    uint8_t               valid = 0u;
+    cy_stc_crypto_ecc_key key   =
+    {
+        .type    = PK_PRIVATE,
+        .curveID = CY_CRYPTO_ECC_ECP_SECP256R1,
+        .pubkey  = { .x = pub_x, .y = pub_y },
+        .k       = (void*)cybsp_crypto_bench_priv
+    };
+    if (ok)
+    {
+        ok = (CY_CRYPTO_SUCCESS == Cy_Crypto_Core_ECC_MakePublicKey(
+                  base, CY_CRYPTO_ECC_ECP_SECP256R1, cybsp_crypto_bench_priv, &key));
+    }
+    if (ok)
+    {
+        start = DWT->CYCCNT;
+        ok    = (CY_CRYPTO_SUCCESS == Cy_Crypto_Core_ECC_SignHash(
+                     base, digest, sizeof(digest), sig, &key, cybsp_crypto_bench_nonce));
+        result->ecdsa_sign_us = cybsp_crypto_bench_us(DWT->CYCCNT - start);
+    }
+    if (ok)
+    {
+        key.type = PK_PUBLIC;
+        start    = DWT->CYCCNT;
+        ok       = (CY_CRYPTO_SUCCESS == Cy_Crypto_Core_ECC_VerifyHash(
+                        base, sig, digest, sizeof(digest), &valid, &key));
+        result->ecdsa_verify_us = cybsp_crypto_bench_us(DWT->CYCCNT - start);
+    }
+
+    return (ok && (1u == valid)) ? CY_RSLT_SUCCESS : CYBSP_RSLT_ERR_CRYPTO_BENCH;
+}
+
+
+//--------------------------------------------------------------------------------------------------
+// cybsp_crypto_bench_run
+//--------------------------------------------------------------------------------------------------
+cy_rslt_t cybsp_crypto_bench_run(uint8_t* buffer, size_t length,
+                                 cybsp_crypto_bench_result_t* result)
+{
+    if ((NULL == buffer) || (NULL == result) || (0u == length) ||
+        (0u != (length % CY_CRYPTO_AES_BLOCK_SIZE)))
+    {
+        return CYBSP_RSLT_ERR_CRYPTO_BENCH;
+    }
+
+    (void)memset(result, 0, sizeof(*result));
+    CoreDebug->DEMCR |= CoreDebug_DEMCR_TRCENA_Msk;
+    DWT->CTRL        |= DWT_CTRL_CYCCNTENA_Msk;
+
+    // AES and SHA belong to the common feature, ECC runs on the vector unit
+    CRYPTO_Type*          base;
+    cyhal_resource_inst_t common;
+    cyhal_resource_inst_t vu;
+    cy_rslt_t             rslt = cyhal_crypto_reserve(&base, &common, CYHAL_CRYPTO_COMMON);
+    if (CY_RSLT_SUCCESS == rslt)
+    {
+        rslt = cyhal_crypto_reserve(&base, &vu, CYHAL_CRYPTO_VU);
+        if (CY_RSLT_SUCCESS == rslt)
+        {
+            rslt = cybsp_crypto_bench_passes(base, buffer, (uint32_t)length, result);
+            cyhal_crypto_free(base, &vu, CYHAL_CRYPTO_VU);
+        }
+        cyhal_crypto_free(base, &common, CYHAL_CRYPTO_COMMON);
+    }
+    return rslt;
+}
+
+
+//--------------------------------------------------------------------------------------------------
+// cybsp_crypto_bench_dump
+//--------------------------------------------------------------------------------------------------
+void cybsp_crypto_bench_dump(const cybsp_crypto_bench_result_t* result,
+                             cybsp_crypto_bench_print_t print_fn)
+{
+    if ((NULL != result) && (NULL != print_fn))
+    {
+        (void)print_fn("SHA-256          %3lu.%03lu MB/s\r\n",
+                       (unsigned long)(result->sha256_kbyte_s / 1000u),
+                       (unsigned long)(result->sha256_kbyte_s % 1000u));
+        (void)print_fn("AES-128-CTR      %3lu.%03lu MB/s\r\n",
+                       (unsigned long)(result->aes128_ctr_kbyte_s / 1000u),
+                       (unsigned long)(result->aes128_ctr_kbyte_s % 1000u));
+        (void)print_fn("ECDSA P-256 sign   %6lu us\r\n", (unsigned long)result->ecdsa_sign_us);
+        (void)print_fn("ECDSA P-256 verify %6lu us\r\n", (unsigned long)result->ecdsa_verify_us);
+    }
+}
+
+
+#if defined(__cplusplus)
+}
+#endif
+
+#endif // defined(CYBSP_CRYPTO_BENCH)
@@ -0,0 +1,91 @@
+/***********************************************************************************************//**
+ * \file cybsp_crypto_bench.h
+ *
+ * \brief
+ * Throughput and latency benchmark of the crypto block.
+ *
+ ***************************************************************************************************
+ * \copyright
+ * Copyright 2023 Cypress Semiconductor Corporation (an Infineon company) or
+ * an affiliate of Cypress Semiconductor Corporation
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ **************************************************************************************************/
+
+#pragma once
+
+#include <stddef.h>
+#include <stdint.h>
+#include "cy_result.h"
+
+#if defined(__cplusplus)
+extern "C" {
+#endif
+
+/**
+ * \addtogroup group_bsp_crypto_bench Crypto Benchmark
+ * \{
+ * When CYBSP_CRYPTO_BENCH is defined, \ref cybsp_crypto_bench_run measures the crypto block
+ * directly through the PDL, without the mbed TLS layers on top:
+ * - SHA-256 and AES-128-CTR throughput over a buffer, the bulk cost of a TLS record,
+ * - ECDSA P-256 sign and verify time, which dominates the CPU time of an ECDHE-ECDSA handshake
+ *   (one signature on the server, certificate chain and handshake signature verification on the
+ *   client).
+ *
+ * Timing uses the DWT cycle counter with interrupts enabled, so other work should be idle while
+ * the benchmark runs. The crypto block is reserved through the HAL for the duration of the run.
+ * The ECDSA pass uses a fixed key and nonce; its signatures must not be used for anything else.
+ */
+
+#if defined(CYBSP_CRYPTO_BENCH)
+
+/** Benchmark results, see \ref cybsp_crypto_bench_run */
+typedef struct
+{
+    uint32_t sha256_kbyte_s;    /**< SHA-256 over the buffer, kB/s */
+    uint32_t aes128_ctr_kbyte_s; /**< AES-128-CTR encryption of the buffer in place, kB/s */
+    uint32_t ecdsa_sign_us;     /**< One ECDSA P-256 signature of a SHA-256 hash */
+    uint32_t ecdsa_verify_us;   /**< One ECDSA P-256 verification of that signature */
+} cybsp_crypto_bench_result_t;
+
+/** printf compatible function used to print the results */
+typedef int (*cybsp_crypto_bench_print_t)(const char* format, ...);
+
+/**
+ * \brief Runs the benchmark.
+ * \param buffer Data for the throughput passes, overwritten by the AES pass
+ * \param length Size of the buffer in bytes, a multiple of 16 (e.g. 16 KB for a TLS record)
+ * \param result Filled with the results
+ * \returns CY_RSLT_SUCCESS if the benchmark completed, CYBSP_RSLT_ERR_CRYPTO_BENCH if an operation
+ *          failed or the signature did not verify, otherwise the error from reserving the block
+ */
+cy_rslt_t cybsp_crypto_bench_run(uint8_t* buffer, size_t length,
+                                 cybsp_crypto_bench_result_t* result);
+
+/**
+ * \brief Prints the results of \ref cybsp_crypto_bench_run.
+ * \param result   Results of \ref cybsp_crypto_bench_run
+ * \param print_fn printf compatible function used for the output
+ */
+void cybsp_crypto_bench_dump(const cybsp_crypto_bench_result_t* result,
+                             cybsp_crypto_bench_print_t print_fn);
+
+#endif // defined(CYBSP_CRYPTO_BENCH)
+
+/** \} group_bsp_crypto_bench */
+
+#ifdef __cplusplus
+}
+#endif // __cplusplus
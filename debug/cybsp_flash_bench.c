@@ -0,0 +1,391 @@
+/***********************************************************************************************//**
+ * \file cybsp_flash_bench.c
+ *
+ * Description:
+ * Read, program and erase benchmark of the internal flash regions and the QSPI flash.
+ *
+ ***************************************************************************************************
+ * \copyright
+ * Copyright 2023 Cypress Semiconductor Corporation (an Infineon company) or
+ * an affiliate of Cypress Semiconductor Corporation
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ **************************************************************************************************/
+
+#if defined(CYBSP_FLASH_BENCH)
+
+#include <stddef.h>
+#include "cy_device_headers.h"
+#include "cy_syslib.h"
+#include "cy_flash.h"
+#include "system_psoc6.h"
+#include "cybsp.h"
+#include "cybsp_flash_bench.h"
+#if defined(CYBSP_XIP)
+#include "cy_smif_memslot.h"
+#include "cycfg_qspi_memslot.h"
+#endif
+
+#if defined(__cplusplus)
+extern "C" {
+#endif
+
+#define CYBSP_FLASH_BENCH_ROW_SIZE      (CY_FLASH_SIZEOF_ROW)
+// The flash read probe walks the start of the CM4 application flash, larger than the flash cache
+#define CYBSP_FLASH_BENCH_PROBE_BASE    (0x10180000UL)
+#define CYBSP_FLASH_BENCH_PROBE_SIZE    (0x00010000UL)
+#define CYBSP_FLASH_BENCH_PROBE_MASK    (CYBSP_FLASH_BENCH_PROBE_SIZE - 1u)
+#define CYBSP_FLASH_BENCH_PROBE_STRIDE  (32u)
+// Length of each probe window, well below the duration of a row write
+#define CYBSP_FLASH_BENCH_WINDOW_US     (500u)
+
+typedef struct
+{
+    uint32_t base;
+    uint32_t size;
+} cybsp_flash_bench_span_t;
+
+// Non-blocking write measurement, filled from SRAM
+typedef struct
+{
+    uint32_t                start;      // Cycle count when the write was started
+    uint32_t                returned;   // Cycles until Cy_Flash_StartWrite() returned
+    uint32_t                cpu;        // SRAM probe iterations during the write
+    uint32_t                read;       // Flash read probe iterations during the write
+    cy_en_flashdrv_status_t status;     // Result of Cy_Flash_StartWrite()
+} cybsp_flash_bench_nb_t;
+
+// Spans used for the read measurement
+static const cybsp_flash_bench_span_t cybsp_flash_bench_read_spans[CYBSP_FLASH_REGION_COUNT] =
+{
+    { 0x10180000UL, 0x10000UL },
+    { 0x14000000UL, 0x08000UL },
+    { 0x16000800UL, 0x00800UL },
+    { 0x18000000UL, 0x10000UL }
+};
+
+static const char* const cybsp_flash_bench_names[CYBSP_FLASH_REGION_COUNT] =
+{
+    "Main flash",
+    "Em_EEPROM",
+    "SFlash user",
+    "QSPI"
+};
+
+static uint32_t          cybsp_flash_bench_row[CYBSP_FLASH_BENCH_ROW_SIZE / sizeof(uint32_t)];
+// Keeps the loads from being optimized away
+static volatile uint32_t cybsp_flash_bench_sink;
+
+//--------------------------------------------------------------------------------------------------
+// cybsp_flash_bench_us
+//--------------------------------------------------------------------------------------------------
+static uint32_t cybsp_flash_bench_us(uint32_t cycles)
+{
+    uint32_t mhz = SystemCoreClock / 1000000u;
+    return (0u != mhz) ? (cycles / mhz) : 0u;
+}
+
+
+//--------------------------------------------------------------------------------------------------
+// cybsp_flash_bench_kbyte_s
+//--------------------------------------------------------------------------------------------------
+static uint32_t cybsp_flash_bench_kbyte_s(uint32_t bytes, uint32_t cycles)
+{
+    return (0u != cycles)
+        ? (uint32_t)(((uint64_t)bytes * (SystemCoreClock / 1000u)) / cycles)
+        : 0u;
+}
+
+
+//--------------------------------------------------------------------------------------------------
+// cybsp_flash_bench_pct
+//--------------------------------------------------------------------------------------------------
+static uint8_t cybsp_flash_bench_pct(uint32_t during, uint32_t idle)
+{
+    uint32_t pct = (0u != idle) ? (uint32_t)(((uint64_t)during * 100u) / idle) : 0u;
+    return (uint8_t)((pct > 100u) ? 100u : pct);
+}
+
+
+//--------------------------------------------------------------------------------------------------
+// cybsp_flash_bench_read
+//--------------------------------------------------------------------------------------------------
+static uint32_t cybsp_flash_bench_read(const cybsp_flash_bench_span_t* span)
+{
+    const volatile uint32_t* data = (const volatile uint32_t*)span->base;
+    uint32_t                 sum  = 0u;
+
+    uint32_t savedIntrStatus = Cy_SysLib_EnterCriticalSection();
+    uint32_t start           = DWT->CYCCNT;
+    for (uint32_t i = 0u; i < (span->size / sizeof(uint32_t)); i++)
+    {
+        sum += data[i];
+    }
+    uint32_t cycles = DWT->CYCCNT - start;
+    Cy_SysLib_ExitCriticalSection(savedIntrStatus);
+
+    cybsp_flash_bench_sink = sum;
+    return cybsp_flash_bench_kbyte_s(span->size, cycles);
+}
+
+
+//--------------------------------------------------------------------------------------------------
+// cybsp_flash_bench_probe
+//
+// Counts loop iterations for a number of cycles. Runs from SRAM with interrupts disabled and
+// touches flash only when read_flash is set.
+//--------------------------------------------------------------------------------------------------
+CY_RAMFUNC_BEGIN
+static uint32_t cybsp_flash_bench_probe(uint32_t window, bool read_flash)
+{
+    uint32_t count  = 0u;
+    uint32_t offset = 0u;
+    uint32_t sum    = 0u;
+
+    uint32_t primask = __get_PRIMASK();
+    __disable_irq();
+    uint32_t start = DWT->CYCCNT;
+    while ((DWT->CYCCNT - start) < window)
+    {
+        if (read_flash)
+        {
+            sum    += *(const volatile uint32_t*)(CYBSP_FLASH_BENCH_PROBE_BASE + offset);
+            offset  = (offset + CYBSP_FLASH_BENCH_PROBE_STRIDE) & CYBSP_FLASH_BENCH_PROBE_MASK;
+        }
+        count++;
+    }
+    __set_PRIMASK(primask);
+
+    cybsp_flash_bench_sink = sum;
+    return count;
+}
+CY_RAMFUNC_END
+
+
+//--------------------------------------------------------------------------------------------------
+// cybsp_flash_bench_nb_write
+//
+// Starts a non-blocking row write and probes the system while it is in progress. Runs from SRAM
+// so the probes are not delayed by instruction fetches from the busy flash.
+//--------------------------------------------------------------------------------------------------
+CY_RAMFUNC_BEGIN
+static void cybsp_flash_bench_nb_write(uint32_t row, uint32_t window, cybsp_flash_bench_nb_t* nb)
+{
+    nb->start    = DWT->CYCCNT;
+    nb->status   = Cy_Flash_StartWrite(row, cybsp_flash_bench_row);
+    nb->returned = DWT->CYCCNT - nb->start;
+    nb->cpu      = cybsp_flash_bench_probe(window, false);
+    nb->read     = cybsp_flash_bench_probe(window, true);
+}
+CY_RAMFUNC_END
+
+
+//--------------------------------------------------------------------------------------------------
+// cybsp_flash_bench_internal
+//
+// The supervisory flash cannot be erased on its own, so erase and program are skipped there.
+//--------------------------------------------------------------------------------------------------
+static cy_rslt_t cybsp_flash_bench_internal(uint32_t row, bool can_erase,
+                                            cybsp_flash_bench_result_t* result)
+{
+    uint32_t start;
+    if (can_erase)
+    {
+        start = DWT->CYCCNT;
+        if (CY_FLASH_DRV_SUCCESS != Cy_Flash_EraseRow(row))
+        {
+            return CYBSP_RSLT_ERR_FLASH_BENCH;
+        }
+        result->erase_us = cybsp_flash_bench_us(DWT->CYCCNT - start);
+
+        start = DWT->CYCCNT;
+        if (CY_FLASH_DRV_SUCCESS != Cy_Flash_ProgramRow(row, cybsp_flash_bench_row))
+        {
+            return CYBSP_RSLT_ERR_FLASH_BENCH;
+        }
+        uint32_t cycles = DWT->CYCCNT - start;
+        result->program_us      = cybsp_flash_bench_us(cycles);
+        result->program_kbyte_s = cybsp_flash_bench_kbyte_s(CYBSP_FLASH_BENCH_ROW_SIZE, cycles);
+    }
+
+    start = DWT->CYCCNT;
+    if (CY_FLASH_DRV_SUCCESS != Cy_Flash_WriteRow(row, cybsp_flash_bench_row))
+    {
+        return CYBSP_RSLT_ERR_FLASH_BENCH;
+    }
+    result->write_us = cybsp_flash_bench_us(DWT->CYCCNT - start);
+
+    uint32_t               window   = (SystemCoreClock / 1000000u) * CYBSP_FLASH_BENCH_WINDOW_US;
+    uint32_t               cpu_idle = cybsp_flash_bench_probe(window, false);
+    uint32_t               rd_idle  = cybsp_flash_bench_probe(window, true);
+    cybsp_flash_bench_nb_t nb;
+    cybsp_flash_bench_nb_write(row, window, &nb);
+    if (CY_FLASH_DRV_SUCCESS != nb.status)
+    {
+        return CYBSP_RSLT_ERR_FLASH_BENCH;
+    }
+
+    cy_en_flashdrv_status_t status;
+    do
+    {
+        status = Cy_Flash_IsOperationComplete();
+    } while (CY_FLASH_DRV_OPCODE_BUSY == status);
+    if (CY_FLASH_DRV_SUCCESS != status)
+    {
+        return CYBSP_RSLT_ERR_FLASH_BENCH;
+    }
+    result->nb_write_us    = cybsp_flash_bench_us(DWT->CYCCNT - nb.start);
+    result->cpu_pct        = cybsp_flash_bench_pct(nb.cpu, cpu_idle);
+    result->flash_read_pct = cybsp_flash_bench_pct(nb.read, rd_idle);
+    return CY_RSLT_SUCCESS;
+}
+
+
+#if defined(CYBSP_XIP)
+//--------------------------------------------------------------------------------------------------
+// cybsp_flash_bench_qspi
+//--------------------------------------------------------------------------------------------------
+static cy_rslt_t cybsp_flash_bench_qspi(uint32_t sector, cybsp_flash_bench_result_t* result)
+{
+    cy_stc_smif_context_t*    context = cybsp_xip_get_context();
+    cy_stc_smif_mem_config_t* memory  = smifMemConfigs[0];
+    uint32_t                  address = sector - CYBSP_XIP_START;
+    cy_rslt_t                 status  = CYBSP_RSLT_ERR_FLASH_BENCH;
+
+    // Nothing may execute from the QSPI flash while it is not memory mapped
+    uint32_t savedIntrStatus = Cy_SysLib_EnterCriticalSection();
+    Cy_SMIF_SetMode(SMIF0, CY_SMIF_NORMAL);
+
+    uint32_t start = DWT->CYCCNT;
+    if (CY_SMIF_SUCCESS == Cy_SMIF_MemEraseSector(SMIF0, memory, address,
+                                                  memory->deviceCfg->eraseSize, context))
+    {
+        result->erase_us = cybsp_flash_bench_us(DWT->CYCCNT - start);
+
+        start = DWT->CYCCNT;
+        if (CY_SMIF_SUCCESS == Cy_SMIF_MemWrite(SMIF0, memory, address,
+                                                (const uint8_t*)cybsp_flash_bench_row,
+                                                CYBSP_FLASH_BENCH_ROW_SIZE, context))
+        {
+            uint32_t cycles = DWT->CYCCNT - start;
+            result->program_us      = cybsp_flash_bench_us(cycles);
+            result->program_kbyte_s = cybsp_flash_bench_kbyte_s(CYBSP_FLASH_BENCH_ROW_SIZE, cycles);
+            status               = CY_RSLT_SUCCESS;
+        }
+    }
+
+    (void)Cy_SMIF_CacheInvalidate(SMIF0, CY_SMIF_CACHE_BOTH);
+    Cy_SMIF_SetMode(SMIF0, CY_SMIF_MEMORY);
+    Cy_SysLib_ExitCriticalSection(savedIntrStatus);
+
+    return status;
+}
+
+
+#endif // defined(CYBSP_XIP)
+
+//--------------------------------------------------------------------------------------------------
+// cybsp_flash_bench_run
+//--------------------------------------------------------------------------------------------------
+cy_rslt_t cybsp_flash_bench_run(const cybsp_flash_bench_config_t* config,
+                                cybsp_flash_bench_result_t results[CYBSP_FLASH_REGION_COUNT])
+{
+    CY_ASSERT(NULL != results);
+
+    CoreDebug->DEMCR |= CoreDebug_DEMCR_TRCENA_Msk;
+    DWT->CTRL        |= DWT_CTRL_CYCCNTENA_Msk;
+
+    for (uint32_t i = 0u; i < (CYBSP_FLASH_BENCH_ROW_SIZE / sizeof(uint32_t)); i++)
+    {
+        cybsp_flash_bench_row[i] = 0x5A5A0000u | i;
+    }
+
+    for (uint32_t r = 0u; r < CYBSP_FLASH_REGION_COUNT; r++)
+    {
+        results[r] = (cybsp_flash_bench_result_t) { 0u };
+        #if !defined(CYBSP_XIP)
+        if (CYBSP_FLASH_REGION_QSPI == r)
+        {
+            continue;
+        }
+        #endif
+        results[r].read_kbyte_s = cybsp_flash_bench_read(&cybsp_flash_bench_read_spans[r]);
+    }
+
+    cy_rslt_t result = CY_RSLT_SUCCESS;
+    if (NULL != config)
+    {
+        const uint32_t rows[CYBSP_FLASH_REGION_COUNT] =
+        {
+            config->main_row, config->em_eeprom_row, config->sflash_row, config->qspi_sector
+        };
+        for (uint32_t r = 0u; r < CYBSP_FLASH_REGION_COUNT; r++)
+        {
+            cy_rslt_t region_result = CY_RSLT_SUCCESS;
+            if (CYBSP_FLASH_REGION_QSPI == r)
+            {
+                #if defined(CYBSP_XIP)
+                if (0u != rows[r])
+                {
+                    region_result = cybsp_flash_bench_qspi(rows[r], &results[r]);
+                }
+                #endif
+            }
+            else if (0u != rows[r])
+            {
+                region_result = cybsp_flash_bench_internal(rows[r],
+                                                           (CYBSP_FLASH_REGION_SFLASH_USER != r),
+                                                           &results[r]);
+            }
+
+            if (CY_RSLT_SUCCESS == result)
+            {
+                result = region_result;
+            }
+        }
+    }
+
+    return result;
+}
+
+
+//--------------------------------------------------------------------------------------------------
+// cybsp_flash_bench_dump
+//--------------------------------------------------------------------------------------------------
+void cybsp_flash_bench_dump(const cybsp_flash_bench_result_t results[CYBSP_FLASH_REGION_COUNT],
+                            cybsp_flash_bench_print_t print_fn)
+{
+    if ((NULL != results) && (NULL != print_fn))
+    {
+        for (uint32_t r = 0u; r < CYBSP_FLASH_REGION_COUNT; r++)
+        {
+            const cybsp_flash_bench_result_t* res = &results[r];
+            (void)print_fn("%-12s read %6lu kB/s  erase %7lu us  program %6lu us (%4lu kB/s)  "
+                           "write %6lu us  non-blocking %6lu us (CPU %3u%%, flash reads %3u%%)\r\n",
+                           cybsp_flash_bench_names[r],
+                           (unsigned long)res->read_kbyte_s, (unsigned long)res->erase_us,
+                           (unsigned long)res->program_us, (unsigned long)res->program_kbyte_s,
+                           (unsigned long)res->write_us, (unsigned long)res->nb_write_us,
+                           (unsigned)res->cpu_pct, (unsigned)res->flash_read_pct);
+        }
+    }
+}
+
+
+#if defined(__cplusplus)
+}
+#endif
+
+#endif // defined(CYBSP_FLASH_BENCH)
@@ -0,0 +1,123 @@
+/***********************************************************************************************//**
+ * \file cybsp_flash_bench.h
+ *
+ * \brief
+ * Read, program and erase benchmark of the internal flash regions and the QSPI flash.
+ *
+ ***************************************************************************************************
+ * \copyright
+ * Copyright 2023 Cypress Semiconductor Corporation (an Infineon company) or
+ * an affiliate of Cypress Semiconductor Corporation
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ **************************************************************************************************/
+
+#pragma once
+
+#include <stdbool.h>
+#include <stdint.h>
+#include "cy_result.h"
+
+#if defined(__cplusplus)
+extern "C" {
+#endif
+
+/**
+ * \addtogroup group_bsp_flash_bench Flash Benchmark
+ * \{
+ * Measures every non-volatile region of the board with the DWT cycle counter:
+ * - CPU read throughput over a fixed span of the region (non-destructive)
+ * - Blocking row erase, row program and row write (erase + program) latency
+ * - Non-blocking row write latency, and how much of the CPU and of the flash read bandwidth
+ *   remain available while it is in progress
+ *
+ * Flash operations of the CM4 are executed by the SROM through the CM0+, and code executing from
+ * flash (including the network processor image on the CM0+) stalls while the flash is busy.
+ * During a non-blocking write the benchmark therefore runs two probes from SRAM for a short
+ * window: a loop that does not touch memory, and a loop that reads the CM4 application flash with
+ * a stride that defeats the flash cache. Their progress relative to an idle baseline is reported
+ * as \ref cybsp_flash_bench_result_t::cpu_pct and \ref cybsp_flash_bench_result_t::flash_read_pct;
+ * a flash read availability close to 0 means the CM0+ cannot fetch code while the CM4 writes.
+ *
+ * The rows (sector for QSPI) given in \ref cybsp_flash_bench_config_t are erased and overwritten.
+ * For QSPI (CYBSP_XIP only) SMIF leaves memory mode during the operations, which run with
+ * interrupts disabled, so the benchmark must not execute from the QSPI flash. Measurements that
+ * are not supported by a region (e.g. a plain erase of supervisory flash) or were skipped are
+ * reported as 0.
+ */
+
+#if defined(CYBSP_FLASH_BENCH)
+
+/** Regions covered by the benchmark */
+typedef enum
+{
+    CYBSP_FLASH_REGION_MAIN,        /**< CM4 application flash at 0x10180000 */
+    CYBSP_FLASH_REGION_EM_EEPROM,   /**< 32 KB emulated EEPROM region at 0x14000000 */
+    CYBSP_FLASH_REGION_SFLASH_USER, /**< Supervisory flash user data at 0x16000800 */
+    CYBSP_FLASH_REGION_QSPI,        /**< Memory mapped QSPI flash at 0x18000000 (CYBSP_XIP) */
+    CYBSP_FLASH_REGION_COUNT        /**< Number of regions, not a valid region */
+} cybsp_flash_region_t;
+
+/** Rows used for the program and erase measurements. 0 skips the region. */
+typedef struct
+{
+    uint32_t main_row;              /**< Spare row in the CM4 application flash */
+    uint32_t em_eeprom_row;         /**< Row in the emulated EEPROM region */
+    uint32_t sflash_row;            /**< Row in the supervisory flash user data */
+    uint32_t qspi_sector;           /**< Sector in the memory mapped QSPI flash */
+} cybsp_flash_bench_config_t;
+
+/** Results for one region. Latencies are in microseconds, throughputs in kB/s. */
+typedef struct
+{
+    uint32_t read_kbyte_s;          /**< Sequential 32-bit CPU reads */
+    uint32_t erase_us;              /**< Blocking row erase (sector erase for QSPI) */
+    uint32_t program_us;            /**< Blocking program of an erased row (page for QSPI) */
+    uint32_t write_us;              /**< Blocking erase + program of a row */
+    uint32_t program_kbyte_s;       /**< Program throughput derived from program_us */
+    uint32_t nb_write_us;           /**< Non-blocking row write from start to completion */
+    uint8_t  cpu_pct;               /**< CPU progress from SRAM during the non-blocking write */
+    uint8_t  flash_read_pct;        /**< Flash read progress during the non-blocking write */
+} cybsp_flash_bench_result_t;
+
+/** printf compatible function used to print the results */
+typedef int (*cybsp_flash_bench_print_t)(const char* format, ...);
+
+/**
+ * \brief Runs the benchmark for all regions.
+ * \param config  Rows to overwrite, or NULL to only measure read throughput
+ * \param results Filled with one entry per \ref cybsp_flash_region_t
+ * \returns CY_RSLT_SUCCESS, or CYBSP_RSLT_ERR_FLASH_BENCH if an erase, program or write operation
+ *          failed. The measurements of a region stop at its first failure; the other regions are
+ *          still measured.
+ */
+cy_rslt_t cybsp_flash_bench_run(const cybsp_flash_bench_config_t* config,
+                                cybsp_flash_bench_result_t results[CYBSP_FLASH_REGION_COUNT]);
+
+/**
+ * \brief Prints the results of \ref cybsp_flash_bench_run.
+ * \param results  Results of \ref cybsp_flash_bench_run
+ * \param print_fn printf compatible function used for the output
+ */
+void cybsp_flash_bench_dump(const cybsp_flash_bench_result_t results[CYBSP_FLASH_REGION_COUNT],
+                            cybsp_flash_bench_print_t print_fn);
+
+#endif // defined(CYBSP_FLASH_BENCH)
+
+/** \} group_bsp_flash_bench */
+
+#ifdef __cplusplus
+}
+#endif // __cplusplus
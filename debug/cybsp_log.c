@@ -0,0 +1,261 @@
+/***********************************************************************************************//**
+ * \file cybsp_log.c
+ *
+ * Description:
+ * Ring buffered debug UART output, sent in the background by DMA.
+ *
+ ***************************************************************************************************
+ * \copyright
+ * Copyright 2023 Cypress Semiconductor Corporation (an Infineon company) or
+ * an affiliate of Cypress Semiconductor Corporation
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ **************************************************************************************************/
+
+#if defined(CYBSP_LOG)
+
+#include <stdarg.h>
+#include <stdbool.h>
+#include <stdio.h>
+#include <string.h>
+#include "cy_syslib.h"
+#include "cyhal_uart.h"
+#include "cybsp.h"
+
+#if defined(__cplusplus)
+extern "C" {
+#endif
+
+#define CYBSP_LOG_BUFFER_MASK       (CYBSP_LOG_BUFFER_SIZE - 1u)
+
+#if (0u != (CYBSP_LOG_BUFFER_SIZE & CYBSP_LOG_BUFFER_MASK))
+    #error "CYBSP_LOG_BUFFER_SIZE must be a power of two"
+#endif
+
+static cyhal_uart_t      cybsp_log_uart;
+static uint8_t           cybsp_log_buffer[CYBSP_LOG_BUFFER_SIZE];
+// Free running indices, only their difference is limited to the buffer size
+static volatile uint32_t cybsp_log_head     = 0u;
+static volatile uint32_t cybsp_log_tail     = 0u;
+// Length of the DMA transfer in progress, 0 when the UART is idle
+static volatile uint32_t cybsp_log_inflight = 0u;
+static cybsp_log_stats_t cybsp_log_stats;
+
+//--------------------------------------------------------------------------------------------------
+// cybsp_log_start_transfer
+//
+// Sends the oldest contiguous part of the buffer. Called with interrupts disabled or from the UART
+// interrupt.
+//--------------------------------------------------------------------------------------------------
+static void cybsp_log_start_transfer(void)
+{
+    uint32_t tail   = cybsp_log_tail;
+    uint32_t offset = tail & CYBSP_LOG_BUFFER_MASK;
+    uint32_t length = cybsp_log_head - tail;
+
+    // A transfer never wraps around the end of the buffer
+    if (length > (CYBSP_LOG_BUFFER_SIZE - offset))
+    {
+        length = CYBSP_LOG_BUFFER_SIZE - offset;
+    }
+
+    if ((0u != length) &&
+        (CY_RSLT_SUCCESS ==
+         cyhal_uart_write_async(&cybsp_log_uart, &cybsp_log_buffer[offset], length)))
+    {
+        #if defined(CYBSP_SLEEP_POLICY)
+        if (0u == cybsp_log_inflight)
+        {
+            cybsp_sleep_policy_lock(CYBSP_SLEEP_CLIENT_DEBUG_UART);
+        }
+        #endif
+        cybsp_log_inflight = length;
+        cybsp_log_stats.transfers++;
+    }
+    else if (0u != cybsp_log_inflight)
+    {
+        cybsp_log_inflight = 0u;
+        #if defined(CYBSP_SLEEP_POLICY)
+        (void)cybsp_sleep_policy_unlock(CYBSP_SLEEP_CLIENT_DEBUG_UART);
+        #endif
+    }
+}
+
+
+//--------------------------------------------------------------------------------------------------
+// cybsp_log_uart_event
+//--------------------------------------------------------------------------------------------------
+static void cybsp_log_uart_event(void* callback_arg, cyhal_uart_event_t event)
+{
+    CY_UNUSED_PARAMETER(callback_arg);
+
+    if (0u != (event & CYHAL_UART_IRQ_TX_TRANSMIT_IN_FIFO))
+    {
+        // The last bytes are still in the UART FIFO, which allows refilling without a gap
+        cybsp_log_tail += cybsp_log_inflight;
+        cybsp_log_start_transfer();
+    }
+}
+
+
+//--------------------------------------------------------------------------------------------------
+// cybsp_log_init
+//--------------------------------------------------------------------------------------------------
+cy_rslt_t cybsp_log_init(void)
+{
+    const cyhal_uart_cfg_t cfg =
+    {
+        .data_bits      = 8u,
+        .stop_bits      = 1u,
+        .parity         = CYHAL_UART_PARITY_NONE,
+        .rx_buffer      = NULL,
+        .rx_buffer_size = 0u
+    };
+
+    cy_rslt_t result = cyhal_uart_init(&cybsp_log_uart, CYBSP_DEBUG_UART_TX, CYBSP_DEBUG_UART_RX,
+                                       CYBSP_LOG_UART_CTS, CYBSP_LOG_UART_RTS, NULL, &cfg);
+    if (CY_RSLT_SUCCESS == result)
+    {
+        result = cyhal_uart_set_baud(&cybsp_log_uart, CYBSP_LOG_BAUD, NULL);
+    }
+    if (CY_RSLT_SUCCESS == result)
+    {
+        result = cyhal_uart_enable_flow_control(&cybsp_log_uart, (NC != CYBSP_LOG_UART_CTS),
+                                                (NC != CYBSP_LOG_UART_RTS));
+    }
+    if (CY_RSLT_SUCCESS == result)
+    {
+        result = cyhal_uart_set_async_mode(&cybsp_log_uart, CYHAL_ASYNC_DMA,
+                                           CYHAL_DMA_PRIORITY_DEFAULT);
+    }
+    if (CY_RSLT_SUCCESS == result)
+    {
+        cyhal_uart_register_callback(&cybsp_log_uart, cybsp_log_uart_event, NULL);
+        cyhal_uart_enable_event(&cybsp_log_uart, CYHAL_UART_IRQ_TX_TRANSMIT_IN_FIFO,
+                                CYBSP_LOG_INTR_PRIORITY, true);
+    }
+    else
+    {
+        cyhal_uart_free(&cybsp_log_uart);
+    }
+    return result;
+}
+
+
+//--------------------------------------------------------------------------------------------------
+// cybsp_log_write
+//--------------------------------------------------------------------------------------------------
+cy_rslt_t cybsp_log_write(const void* data, size_t length)
+{
+    CY_ASSERT((NULL != data) || (0u == length));
+
+    cy_rslt_t result          = CY_RSLT_SUCCESS;
+    uint32_t  savedIntrStatus = Cy_SysLib_EnterCriticalSection();
+    uint32_t  head            = cybsp_log_head;
+    uint32_t  used            = head - cybsp_log_tail;
+
+    if (length > (CYBSP_LOG_BUFFER_SIZE - used))
+    {
+        cybsp_log_stats.dropped++;
+        cybsp_log_stats.dropped_bytes += (uint32_t)length;
+        result = CYBSP_RSLT_ERR_LOG_FULL;
+    }
+    else if (0u != length)
+    {
+        uint32_t offset = head & CYBSP_LOG_BUFFER_MASK;
+        uint32_t first  = CYBSP_LOG_BUFFER_SIZE - offset;
+        if (first > length)
+        {
+            first = (uint32_t)length;
+        }
+        (void)memcpy(&cybsp_log_buffer[offset], data, first);
+        (void)memcpy(cybsp_log_buffer, (const uint8_t*)data + first, length - first);
+
+        cybsp_log_head = head + (uint32_t)length;
+        used          += (uint32_t)length;
+        if (used > cybsp_log_stats.high_water)
+        {
+            cybsp_log_stats.high_water = used;
+        }
+        cybsp_log_stats.written++;
+
+        if (0u == cybsp_log_inflight)
+        {
+            cybsp_log_start_transfer();
+        }
+    }
+    Cy_SysLib_ExitCriticalSection(savedIntrStatus);
+
+    return result;
+}
+
+
+//--------------------------------------------------------------------------------------------------
+// cybsp_log_printf
+//--------------------------------------------------------------------------------------------------
+int cybsp_log_printf(const char* format, ...)
+{
+    char    line[CYBSP_LOG_LINE_MAX];
+    va_list args;
+
+    va_start(args, format);
+    int length = vsnprintf(line, sizeof(line), format, args);
+    va_end(args);
+
+    if (length < 0)
+    {
+        return length;
+    }
+    if ((uint32_t)length >= sizeof(line))
+    {
+        length = (int)sizeof(line) - 1;
+    }
+    return (CY_RSLT_SUCCESS == cybsp_log_write(line, (size_t)length)) ? length : -1;
+}
+
+
+//--------------------------------------------------------------------------------------------------
+// cybsp_log_flush
+//--------------------------------------------------------------------------------------------------
+void cybsp_log_flush(void)
+{
+    while (0u != cybsp_log_inflight)
+    {
+        // Drained from the UART interrupt
+    }
+    while (cyhal_uart_is_tx_active(&cybsp_log_uart))
+    {
+    }
+}
+
+
+//--------------------------------------------------------------------------------------------------
+// cybsp_log_get_stats
+//--------------------------------------------------------------------------------------------------
+void cybsp_log_get_stats(cybsp_log_stats_t* stats)
+{
+    CY_ASSERT(NULL != stats);
+
+    uint32_t savedIntrStatus = Cy_SysLib_EnterCriticalSection();
+    *stats = cybsp_log_stats;
+    Cy_SysLib_ExitCriticalSection(savedIntrStatus);
+}
+
+
+#if defined(__cplusplus)
+}
+#endif
+
+#endif // defined(CYBSP_LOG)
@@ -0,0 +1,141 @@
+/***********************************************************************************************//**
+ * \file cybsp_log.h
+ *
+ * \brief
+ * Non-blocking debug UART log output drained by DMA.
+ *
+ ***************************************************************************************************
+ * \copyright
+ * Copyright 2023 Cypress Semiconductor Corporation (an Infineon company) or
+ * an affiliate of Cypress Semiconductor Corporation
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ **************************************************************************************************/
+
+#pragma once
+
+#include <stddef.h>
+#include <stdint.h>
+#include "cy_result.h"
+
+#if defined(__cplusplus)
+extern "C" {
+#endif
+
+/**
+ * \addtogroup group_bsp_log Log Output
+ * \{
+ * When CYBSP_LOG is defined, the BSP provides a log backend on the debug UART
+ * (\ref CYBSP_DEBUG_UART_TX, SCB10) that never waits for the UART. Messages are copied into an
+ * SRAM ring buffer and the buffer is sent in the background with asynchronous HAL transfers
+ * through a DMA channel, at \ref CYBSP_LOG_BAUD and with RTS/CTS flow control. The caller only
+ * pays for formatting the message and copying it; a message that does not fit into the free part
+ * of the buffer is dropped as a whole and counted, see \ref cybsp_log_get_stats.
+ *
+ * Writers are serialized by a critical section around the copy only, so messages can be written
+ * from any task or interrupt and are never interleaved. The critical section is bounded by
+ * \ref CYBSP_LOG_LINE_MAX bytes.
+ *
+ * The log backend owns SCB10 and its pins, so it cannot be used together with retarget-io on the
+ * debug UART. \ref cybsp_log_printf has the signature of the print functions taken by the dump
+ * functions of the BSP, such as \ref cybsp_boot_profile_dump.
+ *
+ * With CYBSP_SLEEP_POLICY, the \ref CYBSP_SLEEP_CLIENT_DEBUG_UART client holds a deep sleep lock
+ * while the buffer is not empty.
+ */
+
+#if defined(CYBSP_LOG)
+
+#if !defined(CYBSP_LOG_BUFFER_SIZE)
+/** Size of the ring buffer in bytes, must be a power of two. */
+#define CYBSP_LOG_BUFFER_SIZE       (4096u)
+#endif
+
+#if !defined(CYBSP_LOG_LINE_MAX)
+/** Longest message formatted by \ref cybsp_log_printf, longer messages are truncated. */
+#define CYBSP_LOG_LINE_MAX          (128u)
+#endif
+
+#if !defined(CYBSP_LOG_BAUD)
+/** Baud rate of the log output. It is generated exactly from the nominal 100 MHz CLK_PERI. */
+#define CYBSP_LOG_BAUD              (1000000u)
+#endif
+
+#if !defined(CYBSP_LOG_UART_RTS)
+/** RTS pin of the log output, NC to disable. */
+#define CYBSP_LOG_UART_RTS          (P5_6)
+#endif
+
+#if !defined(CYBSP_LOG_UART_CTS)
+/** CTS pin of the log output, NC if the receiver does not drive it. */
+#define CYBSP_LOG_UART_CTS          (P5_7)
+#endif
+
+#if !defined(CYBSP_LOG_INTR_PRIORITY)
+/** Priority of the UART interrupt that restarts the DMA transfers. */
+#define CYBSP_LOG_INTR_PRIORITY     (7u)
+#endif
+
+/** Log statistics, see \ref cybsp_log_get_stats */
+typedef struct
+{
+    uint32_t written;           /**< Messages queued */
+    uint32_t dropped;           /**< Messages dropped because the buffer was full */
+    uint32_t dropped_bytes;     /**< Bytes of the dropped messages */
+    uint32_t high_water;        /**< Largest number of bytes waiting in the buffer */
+    uint32_t transfers;         /**< DMA transfers started */
+} cybsp_log_stats_t;
+
+/**
+ * \brief Initializes the debug UART, its DMA channel and the ring buffer.
+ * \returns CY_RSLT_SUCCESS if the log output is ready, otherwise the error of the HAL UART driver
+ */
+cy_rslt_t cybsp_log_init(void);
+
+/**
+ * \brief Queues raw bytes for output. Does not wait for the UART.
+ * \param data   Bytes to send
+ * \param length Number of bytes
+ * \returns CY_RSLT_SUCCESS if the bytes were queued, CYBSP_RSLT_ERR_LOG_FULL if they were dropped
+ *          because the free space in the buffer was too small
+ */
+cy_rslt_t cybsp_log_write(const void* data, size_t length);
+
+/**
+ * \brief Formats a message and queues it for output. Does not wait for the UART.
+ * \param format printf format string
+ * \returns The number of characters queued, or a negative value if the message was dropped
+ */
+int cybsp_log_printf(const char* format, ...);
+
+/**
+ * \brief Waits until all queued bytes have been moved to the UART.
+ * Intended for use before a reset. Must not be called with interrupts disabled.
+ */
+void cybsp_log_flush(void);
+
+/**
+ * \brief Returns the log statistics.
+ * \param stats Filled with the statistics
+ */
+void cybsp_log_get_stats(cybsp_log_stats_t* stats);
+
+#endif // defined(CYBSP_LOG)
+
+/** \} group_bsp_log */
+
+#ifdef __cplusplus
+}
+#endif // __cplusplus
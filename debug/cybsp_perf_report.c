@@ -0,0 +1,421 @@
+/***********************************************************************************************//**
+ * \file cybsp_perf_report.c
+ *
+ * Description:
+ * Collects the figures of the enabled measurement features into a key=value report.
+ *
+ ***************************************************************************************************
+ * \copyright
+ * Copyright 2023 Cypress Semiconductor Corporation (an Infineon company) or
+ * an affiliate of Cypress Semiconductor Corporation
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ **************************************************************************************************/
+
+#if defined(CYBSP_PERF_REPORT)
+
+#include <stddef.h>
+#include "cy_syslib.h"
+#include "system_psoc6.h"
+#include "cybsp.h"
+
+#if defined(__cplusplus)
+extern "C" {
+#endif
+
+static cybsp_perf_report_print_t cybsp_perf_report_print = NULL;
+static uint32_t                  cybsp_perf_report_count = 0u;
+
+#if defined(CYBSP_BOOT_PROFILE)
+static const char* const cybsp_perf_report_boot_keys[CYBSP_BOOT_PHASE_COUNT] =
+{
+    "system_init_us",
+    "pdl_init_us",
+    "wdt_disable_us",
+    "ipc_init_us",
+    "flash_init_us",
+    "xip_init_us",
+    "bsp_init_us",
+    "hwmgr_init_us",
+    "syspm_init_us",
+    "cycfg_init_us",
+    "clock_profile_us",
+    "pm_callback_us",
+    "np_reserve_us",
+    "reset_to_main_us"
+};
+#endif
+
+#if defined(CYBSP_FLASH_BENCH)
+static const char* const cybsp_perf_report_flash_regions[CYBSP_FLASH_REGION_COUNT] =
+{
+    "flash.main.",
+    "flash.em_eeprom.",
+    "flash.sflash_user.",
+    "flash.qspi."
+};
+#endif
+
+#if defined(CYBSP_XIP)
+static const char* const cybsp_perf_report_xip_profiles[CYBSP_XIP_CACHE_PROFILE_COUNT] =
+{
+    "xip.random_code.",
+    "xip.streaming.",
+    "xip.uncached."
+};
+#endif
+
+#if defined(CYBSP_POWER_STATS)
+static const char* const cybsp_perf_report_perf_levels[CYBSP_PERF_LEVEL_COUNT] =
+{
+    "active_low_ms",
+    "active_nominal_ms",
+    "active_high_ms"
+};
+
+// Accumulated times at reset, all zero
+static const cybsp_power_stats_t cybsp_perf_report_reset_stats;
+#endif
+
+//--------------------------------------------------------------------------------------------------
+// cybsp_perf_report_emit
+//--------------------------------------------------------------------------------------------------
+static void cybsp_perf_report_emit(const char* prefix, const char* key, uint32_t value)
+{
+    if (NULL != cybsp_perf_report_print)
+    {
+        (void)cybsp_perf_report_print("perf %s%s=%lu\r\n", prefix, key, (unsigned long)value);
+        cybsp_perf_report_count++;
+    }
+}
+
+
+#if defined(CYBSP_BOOT_PROFILE) || defined(CYBSP_IPC_JOB)
+//--------------------------------------------------------------------------------------------------
+// cybsp_perf_report_cycles_to_us
+//--------------------------------------------------------------------------------------------------
+static uint32_t cybsp_perf_report_cycles_to_us(uint32_t cycles, uint32_t clock_hz)
+{
+    uint32_t mhz = CY_SYSLIB_DIV_ROUNDUP(clock_hz, 1000000UL);
+    return (0u != mhz) ? (cycles / mhz) : 0u;
+}
+
+
+#endif // if defined(CYBSP_BOOT_PROFILE) || defined(CYBSP_IPC_JOB)
+
+#if defined(CYBSP_FLASH_BENCH) || defined(CYBSP_XIP) || defined(CYBSP_CRYPTO_BENCH)
+//--------------------------------------------------------------------------------------------------
+// cybsp_perf_report_chain
+//--------------------------------------------------------------------------------------------------
+static cy_rslt_t cybsp_perf_report_chain(cy_rslt_t first, cy_rslt_t result)
+{
+    return (CY_RSLT_SUCCESS != first) ? first : result;
+}
+
+
+#endif // if defined(CYBSP_FLASH_BENCH) || defined(CYBSP_XIP) || defined(CYBSP_CRYPTO_BENCH)
+
+#if defined(CYBSP_BOOT_PROFILE)
+//--------------------------------------------------------------------------------------------------
+// cybsp_perf_report_boot
+//--------------------------------------------------------------------------------------------------
+static void cybsp_perf_report_boot(void)
+{
+    for (uint32_t i = 0u; i < (uint32_t)CYBSP_BOOT_PHASE_COUNT; i++)
+    {
+        const cybsp_boot_profile_entry_t* entry = cybsp_boot_profile_get((cybsp_boot_phase_t)i);
+        if (NULL != entry)
+        {
+            uint32_t cycles = entry->end_cycles - entry->start_cycles;
+            cybsp_perf_report_emit("boot.", cybsp_perf_report_boot_keys[i],
+                                   cybsp_perf_report_cycles_to_us(cycles, entry->clock_hz));
+        }
+    }
+}
+
+
+#endif // if defined(CYBSP_BOOT_PROFILE)
+
+#if defined(CYBSP_PM_LATENCY)
+//--------------------------------------------------------------------------------------------------
+// cybsp_perf_report_sleep
+//--------------------------------------------------------------------------------------------------
+static void cybsp_perf_report_sleep(void)
+{
+    cybsp_pm_latency_report_t report;
+    cybsp_pm_latency_get_report(&report);
+
+    cybsp_perf_report_emit("sleep.", "deepsleep_count", report.transitions);
+    cybsp_perf_report_emit("sleep.", "entry_us", report.entry_us);
+    cybsp_perf_report_emit("sleep.", "wake_us", report.exit_us);
+    cybsp_perf_report_emit("sleep.", "clock_restore_us", report.clock_restore_us);
+    cybsp_perf_report_emit("sleep.", "max_entry_us", report.max_entry_us);
+    cybsp_perf_report_emit("sleep.", "max_wake_us", report.max_exit_us);
+    cybsp_perf_report_emit("sleep.", "max_clock_restore_us", report.max_clock_restore_us);
+    #if defined(CYBSP_PM_FAST_WAKE)
+    cybsp_perf_report_emit("sleep.", "pll_switch_back_us", report.pll_relock_us);
+    #endif
+}
+
+
+#endif // if defined(CYBSP_PM_LATENCY)
+
+#if defined(CYBSP_IPC_JOB)
+//--------------------------------------------------------------------------------------------------
+// cybsp_perf_report_ipc
+//--------------------------------------------------------------------------------------------------
+static void cybsp_perf_report_ipc(void)
+{
+    cybsp_ipc_job_stats_t stats;
+    cybsp_ipc_job_get_stats(&stats);
+
+    cybsp_perf_report_emit("ipc.", "job_completed_count", stats.completed);
+    cybsp_perf_report_emit("ipc.", "job_failed_count", stats.failed);
+    cybsp_perf_report_emit("ipc.", "job_max_latency_us",
+                           cybsp_perf_report_cycles_to_us(stats.max_latency_cycles,
+                                                          SystemCoreClock));
+}
+
+
+#endif // if defined(CYBSP_IPC_JOB)
+
+#if defined(CYBSP_FLASH_BENCH)
+//--------------------------------------------------------------------------------------------------
+// cybsp_perf_report_flash
+//--------------------------------------------------------------------------------------------------
+static cy_rslt_t cybsp_perf_report_flash(const cybsp_flash_bench_config_t* config)
+{
+    cybsp_flash_bench_result_t results[CYBSP_FLASH_REGION_COUNT];
+    cy_rslt_t                  result = cybsp_flash_bench_run(config, results);
+
+    if (CY_RSLT_SUCCESS == result)
+    {
+        for (uint32_t i = 0u; i < (uint32_t)CYBSP_FLASH_REGION_COUNT; i++)
+        {
+            const char*                       region = cybsp_perf_report_flash_regions[i];
+            const cybsp_flash_bench_result_t* r      = &results[i];
+            cybsp_perf_report_emit(region, "read_kbyte_s", r->read_kbyte_s);
+            cybsp_perf_report_emit(region, "erase_us", r->erase_us);
+            cybsp_perf_report_emit(region, "program_us", r->program_us);
+            cybsp_perf_report_emit(region, "write_us", r->write_us);
+            cybsp_perf_report_emit(region, "program_kbyte_s", r->program_kbyte_s);
+            cybsp_perf_report_emit(region, "nb_write_us", r->nb_write_us);
+            cybsp_perf_report_emit(region, "nb_cpu_pct", r->cpu_pct);
+            cybsp_perf_report_emit(region, "nb_flash_read_pct", r->flash_read_pct);
+        }
+    }
+    return result;
+}
+
+
+#endif // if defined(CYBSP_FLASH_BENCH)
+
+#if defined(CYBSP_XIP)
+//--------------------------------------------------------------------------------------------------
+// cybsp_perf_report_xip
+//--------------------------------------------------------------------------------------------------
+static cy_rslt_t cybsp_perf_report_xip(const cybsp_xip_bench_config_t* config)
+{
+    cybsp_xip_bench_result_t results[CYBSP_XIP_CACHE_PROFILE_COUNT];
+    cy_rslt_t                result = cybsp_xip_bench_run(config, results);
+
+    if (CY_RSLT_SUCCESS == result)
+    {
+        for (uint32_t i = 0u; i < (uint32_t)CYBSP_XIP_CACHE_PROFILE_COUNT; i++)
+        {
+            const char*                     profile = cybsp_perf_report_xip_profiles[i];
+            const cybsp_xip_bench_result_t* r       = &results[i];
+            cybsp_perf_report_emit(profile, "seq_kbyte_s", r->seq_kbyte_s);
+            cybsp_perf_report_emit(profile, "rand_kbyte_s", r->rand_kbyte_s);
+            cybsp_perf_report_emit(profile, "dma_kbyte_s", r->dma_kbyte_s);
+            cybsp_perf_report_emit(profile, "seq_hit_pct", r->seq_hit_pct);
+            cybsp_perf_report_emit(profile, "rand_hit_pct", r->rand_hit_pct);
+        }
+    }
+    return result;
+}
+
+
+#endif // if defined(CYBSP_XIP)
+
+#if defined(CYBSP_CRYPTO_BENCH)
+//--------------------------------------------------------------------------------------------------
+// cybsp_perf_report_crypto
+//--------------------------------------------------------------------------------------------------
+static cy_rslt_t cybsp_perf_report_crypto(uint8_t* buffer, size_t length)
+{
+    cybsp_crypto_bench_result_t r;
+    cy_rslt_t                   result = cybsp_crypto_bench_run(buffer, length, &r);
+
+    if (CY_RSLT_SUCCESS == result)
+    {
+        cybsp_perf_report_emit("crypto.", "sha256_kbyte_s", r.sha256_kbyte_s);
+        cybsp_perf_report_emit("crypto.", "aes128_ctr_kbyte_s", r.aes128_ctr_kbyte_s);
+        cybsp_perf_report_emit("crypto.", "ecdsa_p256_sign_us", r.ecdsa_sign_us);
+        cybsp_perf_report_emit("crypto.", "ecdsa_p256_verify_us", r.ecdsa_verify_us);
+    }
+    return result;
+}
+
+
+#endif // if defined(CYBSP_CRYPTO_BENCH)
+
+#if defined(CYBSP_POWER_STATS)
+//--------------------------------------------------------------------------------------------------
+// cybsp_perf_report_power
+//--------------------------------------------------------------------------------------------------
+static void cybsp_perf_report_power(const cybsp_power_model_t* model)
+{
+    cybsp_power_stats_t stats;
+    cybsp_power_stats_get(&stats);
+
+    uint64_t total_us = stats.sleep_us + stats.deepsleep_us;
+    for (uint32_t i = 0u; i < (uint32_t)CYBSP_PERF_LEVEL_COUNT; i++)
+    {
+        total_us += stats.active_us[i];
+        cybsp_perf_report_emit("power.", cybsp_perf_report_perf_levels[i],
+                               (uint32_t)(stats.active_us[i] / 1000u));
+    }
+    cybsp_perf_report_emit("power.", "sleep_ms", (uint32_t)(stats.sleep_us / 1000u));
+    cybsp_perf_report_emit("power.", "deepsleep_ms", (uint32_t)(stats.deepsleep_us / 1000u));
+    cybsp_perf_report_emit("power.", "sleep_count", stats.sleep_count);
+    cybsp_perf_report_emit("power.", "deepsleep_count", stats.deepsleep_count);
+
+    uint64_t total_ms = total_us / 1000u;
+    if ((NULL != model) && (0u != total_ms))
+    {
+        // Average since reset: charge in uA x ms divided by the time in ms
+        uint64_t charge = cybsp_power_stats_charge(&cybsp_perf_report_reset_stats, &stats, model);
+        cybsp_perf_report_emit("power.", "avg_ua", (uint32_t)(charge / total_ms));
+    }
+}
+
+
+#endif // if defined(CYBSP_POWER_STATS)
+
+#if defined(CYBSP_MEM_USAGE)
+//--------------------------------------------------------------------------------------------------
+// cybsp_perf_report_mem
+//--------------------------------------------------------------------------------------------------
+static void cybsp_perf_report_mem(void)
+{
+    cybsp_mem_usage_t usage;
+    cybsp_mem_usage_get(&usage);
+
+    cybsp_perf_report_emit("mem.", "stack_size_bytes", usage.stack_size);
+    cybsp_perf_report_emit("mem.", "stack_peak_bytes", usage.stack_peak);
+    cybsp_perf_report_emit("mem.", "heap_size_bytes", usage.heap_size);
+    cybsp_perf_report_emit("mem.", "heap_peak_bytes", usage.heap_peak);
+}
+
+
+#endif // if defined(CYBSP_MEM_USAGE)
+
+//--------------------------------------------------------------------------------------------------
+// cybsp_perf_report_begin
+//--------------------------------------------------------------------------------------------------
+void cybsp_perf_report_begin(cybsp_perf_report_print_t print_fn)
+{
+    cybsp_perf_report_print = print_fn;
+    cybsp_perf_report_count = 0u;
+    if (NULL != print_fn)
+    {
+        (void)print_fn("perf_begin board=CYSBSYSKIT-01 core_hz=%lu\r\n",
+                       (unsigned long)SystemCoreClock);
+    }
+}
+
+
+//--------------------------------------------------------------------------------------------------
+// cybsp_perf_report_value
+//--------------------------------------------------------------------------------------------------
+void cybsp_perf_report_value(const char* key, uint32_t value)
+{
+    CY_ASSERT(NULL != key);
+    cybsp_perf_report_emit("", key, value);
+}
+
+
+//--------------------------------------------------------------------------------------------------
+// cybsp_perf_report_run
+//--------------------------------------------------------------------------------------------------
+cy_rslt_t cybsp_perf_report_run(const cybsp_perf_report_config_t* config)
+{
+    cy_rslt_t result = CY_RSLT_SUCCESS;
+    (void)config;
+
+    #if defined(CYBSP_BOOT_PROFILE)
+    cybsp_perf_report_boot();
+    #endif
+    #if defined(CYBSP_PM_LATENCY)
+    cybsp_perf_report_sleep();
+    #endif
+    #if defined(CYBSP_IPC_JOB)
+    cybsp_perf_report_ipc();
+    #endif
+
+    if (NULL != config)
+    {
+        #if defined(CYBSP_FLASH_BENCH)
+        result = cybsp_perf_report_chain(result, cybsp_perf_report_flash(config->flash));
+        #endif
+        #if defined(CYBSP_XIP)
+        if (NULL != config->xip)
+        {
+            result = cybsp_perf_report_chain(result, cybsp_perf_report_xip(config->xip));
+        }
+        #endif
+        #if defined(CYBSP_CRYPTO_BENCH)
+        if (NULL != config->crypto_buffer)
+        {
+            result = cybsp_perf_report_chain(result,
+                                             cybsp_perf_report_crypto(config->crypto_buffer,
+                                                                      config->crypto_length));
+        }
+        #endif
+    }
+
+    // Reported last so the time and memory used by the benchmarks are included
+    #if defined(CYBSP_POWER_STATS)
+    cybsp_perf_report_power((NULL != config) ? config->power_model : NULL);
+    #endif
+    #if defined(CYBSP_MEM_USAGE)
+    cybsp_perf_report_mem();
+    #endif
+
+    return result;
+}
+
+
+//--------------------------------------------------------------------------------------------------
+// cybsp_perf_report_end
+//--------------------------------------------------------------------------------------------------
+void cybsp_perf_report_end(cy_rslt_t result)
+{
+    if (NULL != cybsp_perf_report_print)
+    {
+        (void)cybsp_perf_report_print("perf_end metrics=%lu result=0x%08lx\r\n",
+                                      (unsigned long)cybsp_perf_report_count,
+                                      (unsigned long)result);
+    }
+    cybsp_perf_report_print = NULL;
+}
+
+
+#if defined(__cplusplus)
+}
+#endif
+
+#endif // defined(CYBSP_PERF_REPORT)
@@ -0,0 +1,131 @@
+/***********************************************************************************************//**
+ * \file cybsp_perf_report.h
+ *
+ * \brief
+ * Machine-readable report of the board performance figures for regression tracking.
+ *
+ ***************************************************************************************************
+ * \copyright
+ * Copyright 2023 Cypress Semiconductor Corporation (an Infineon company) or
+ * an affiliate of Cypress Semiconductor Corporation
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ **************************************************************************************************/
+
+#pragma once
+
+#include <stddef.h>
+#include <stdint.h>
+#include "cy_result.h"
+#include "cybsp_flash_bench.h"
+#include "cybsp_xip_bench.h"
+#include "cybsp_power_stats.h"
+
+#if defined(__cplusplus)
+extern "C" {
+#endif
+
+/**
+ * \addtogroup group_bsp_perf_report Performance Report
+ * \{
+ * When CYBSP_PERF_REPORT is defined, \ref cybsp_perf_report_run collects the figures of every
+ * measurement feature enabled in the build and prints them as one metric per line, so a test rack
+ * can parse the debug UART output and compare each release against the previous one:
+ *
+ *     perf_begin board=CYSBSYSKIT-01 core_hz=100000000
+ *     perf boot.system_init_us=1234
+ *     perf flash.main.read_kbyte_s=45678
+ *     perf_end metrics=2 result=0x00000000
+ *
+ * Keys are stable and carry their unit as suffix (_us, _ms, _pct, _ua, _bytes, _count, _kbit_s
+ * for 1000 bits and _kbyte_s for 1000 bytes per second).
+ * The sections and the defines they need are:
+ * | Keys       | Define             | Content                                                  |
+ * | :--------- | :----------------- | :------------------------------------------------------- |
+ * | boot.*     | CYBSP_BOOT_PROFILE | Reset to main and each SystemInit()/cybsp_init() phase    |
+ * | sleep.*    | CYBSP_PM_LATENCY   | Deep sleep entry, wakeup and clock restore latency        |
+ * | ipc.*      | CYBSP_IPC_JOB      | Jobs completed and worst submission to completion time    |
+ * | flash.*    | CYBSP_FLASH_BENCH  | Read, erase, program and write figures per flash region   |
+ * | xip.*      | CYBSP_XIP          | QSPI read bandwidth per cache profile                     |
+ * | crypto.*   | CYBSP_CRYPTO_BENCH | SHA-256, AES-128-CTR and ECDSA P-256                      |
+ * | power.*    | CYBSP_POWER_STATS  | Time per power state and average current                  |
+ * | mem.*      | CYBSP_MEM_USAGE    | Stack and heap peak usage                                 |
+ *
+ * Figures the BSP cannot measure itself, such as Wi-Fi and Bluetooth throughput from the
+ * application's own traffic test, are added with \ref cybsp_perf_report_value between
+ * \ref cybsp_perf_report_begin and \ref cybsp_perf_report_end so they end up in the same report.
+ * The benchmarks run with the caller's context; other work should be idle meanwhile.
+ */
+
+#if defined(CYBSP_PERF_REPORT)
+
+/** printf compatible function used for the report */
+typedef int (*cybsp_perf_report_print_t)(const char* format, ...);
+
+/** Inputs of the benchmarks run by \ref cybsp_perf_report_run */
+typedef struct
+{
+    #if defined(CYBSP_FLASH_BENCH)
+    const cybsp_flash_bench_config_t* flash;        /**< Rows to overwrite, NULL for reads only */
+    #endif
+    #if defined(CYBSP_XIP)
+    const cybsp_xip_bench_config_t*   xip;          /**< QSPI region to read, NULL to skip */
+    #endif
+    #if defined(CYBSP_CRYPTO_BENCH)
+    uint8_t*                          crypto_buffer; /**< Crypto benchmark data, NULL to skip */
+    size_t                            crypto_length; /**< Size of crypto_buffer in bytes */
+    #endif
+    #if defined(CYBSP_POWER_STATS)
+    const cybsp_power_model_t*        power_model;  /**< Currents per state, NULL to skip the
+                                                         average current */
+    #endif
+    uint32_t                          reserved;     /**< Unused, keeps the structure non-empty */
+} cybsp_perf_report_config_t;
+
+/**
+ * \brief Starts a report.
+ * \param print_fn printf compatible function used for the report
+ */
+void cybsp_perf_report_begin(cybsp_perf_report_print_t print_fn);
+
+/**
+ * \brief Adds one metric to the report started by \ref cybsp_perf_report_begin.
+ * \param key   Metric name, dot separated with the unit as suffix (e.g. "wifi.tcp_tx_kbit_s")
+ * \param value Metric value
+ */
+void cybsp_perf_report_value(const char* key, uint32_t value);
+
+/**
+ * \brief Adds the figures of every enabled measurement feature to the report.
+ * Every section is reported even if an earlier one failed.
+ * \param config Benchmark inputs, may be NULL to only report what was recorded without running a
+ *               benchmark
+ * \returns CY_RSLT_SUCCESS, or the error of the first benchmark that failed
+ */
+cy_rslt_t cybsp_perf_report_run(const cybsp_perf_report_config_t* config);
+
+/**
+ * \brief Ends the report with the number of metrics and the result.
+ * \param result Overall result reported to the test rack, e.g. from \ref cybsp_perf_report_run
+ */
+void cybsp_perf_report_end(cy_rslt_t result);
+
+#endif // defined(CYBSP_PERF_REPORT)
+
+/** \} group_bsp_perf_report */
+
+#ifdef __cplusplus
+}
+#endif // __cplusplus
@@ -0,0 +1,263 @@
+/***********************************************************************************************//**
+ * \file cybsp_trace.c
+ *
+ * Description:
+ * Trace output setup (RAM ring or ITM/SWO) and export of the RAM ring.
+ *
+ ***************************************************************************************************
+ * \copyright
+ * Copyright 2023 Cypress Semiconductor Corporation (an Infineon company) or
+ * an affiliate of Cypress Semiconductor Corporation
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ **************************************************************************************************/
+
+#if defined(CYBSP_TRACE)
+
+#include <stddef.h>
+#include "cy_device_headers.h"
+#include "cy_gpio.h"
+#include "cy_sysclk.h"
+#include "system_psoc6.h"
+#include "cyhal_clock.h"
+#include "cyhal_hwmgr.h"
+#include "cybsp.h"
+
+#if defined(__cplusplus)
+extern "C" {
+#endif
+
+#if (0u != (CYBSP_TRACE_BUFFER_RECORDS & (CYBSP_TRACE_BUFFER_RECORDS - 1u)))
+    #error "CYBSP_TRACE_BUFFER_RECORDS must be a power of two"
+#endif
+
+#if (CYBSP_TRACE_ITM_PORT > 31u)
+    #error "CYBSP_TRACE_ITM_PORT must be between 0 and 31"
+#endif
+
+// SWO pin, the DAP output shares it with CYBSP_UART_RX
+#define CYBSP_TRACE_SWO_PORT            GPIO_PRT6
+#define CYBSP_TRACE_SWO_PORT_NUM        (6u)
+#define CYBSP_TRACE_SWO_PIN             (4u)
+
+// Unlock value of the CoreSight lock access registers
+#define CYBSP_TRACE_CS_UNLOCK           (0xC5ACCE55u)
+// TPIU selected pin protocol: NRZ (UART)
+#define CYBSP_TRACE_TPIU_NRZ            (2u)
+// TPIU formatter bypassed, expected by single-source SWO capture
+#define CYBSP_TRACE_TPIU_FFCR_BYPASS    (0x100u)
+// ATB ID of the ITM
+#define CYBSP_TRACE_ITM_BUS_ID          (1u)
+
+cybsp_trace_output_t cybsp_trace_output  = CYBSP_TRACE_OUTPUT_NONE;
+uint32_t             cybsp_trace_next    = 0u;
+// Words of the ring handed to the ITM, only used by CYBSP_TRACE_OUTPUT_SWO
+uint32_t             cybsp_trace_sent    = 0u;
+uint32_t             cybsp_trace_dropped = 0u;
+cybsp_trace_record_t cybsp_trace_buffer[CYBSP_TRACE_BUFFER_RECORDS];
+
+static cyhal_clock_t cybsp_trace_clock;
+static bool          cybsp_trace_swo_ready = false;
+
+//--------------------------------------------------------------------------------------------------
+// cybsp_trace_swo_init
+//--------------------------------------------------------------------------------------------------
+static cy_rslt_t cybsp_trace_swo_init(void)
+{
+    const cyhal_resource_inst_t pin =
+    {
+        .type        = CYHAL_RSC_GPIO,
+        .block_num   = CYBSP_TRACE_SWO_PORT_NUM,
+        .channel_num = CYBSP_TRACE_SWO_PIN
+    };
+
+    cy_rslt_t result = cyhal_hwmgr_reserve(&pin);
+    if (CY_RSLT_SUCCESS == result)
+    {
+        // The trace clock is a peripheral clock divider, run it undivided from CLK_PERI
+        result = cyhal_clock_allocate(&cybsp_trace_clock, CYHAL_CLOCK_BLOCK_PERIPHERAL_8BIT);
+        if (CY_RSLT_SUCCESS != result)
+        {
+            cyhal_hwmgr_free(&pin);
+        }
+    }
+    if (CY_RSLT_SUCCESS == result)
+    {
+        (void)cyhal_clock_set_divider(&cybsp_trace_clock, 1u);
+        (void)cyhal_clock_set_enabled(&cybsp_trace_clock, true, false);
+        (void)Cy_SysClk_PeriphAssignDivider(PCLK_CPUSS_CLOCK_TRACE_IN,
+                                            (cy_en_divider_types_t)cybsp_trace_clock.block,
+                                            cybsp_trace_clock.channel);
+
+        uint32_t trace_hz = cyhal_clock_get_frequency(&cybsp_trace_clock);
+        if (trace_hz < CYBSP_TRACE_SWO_BAUD)
+        {
+            cyhal_clock_free(&cybsp_trace_clock);
+            cyhal_hwmgr_free(&pin);
+            result = CYBSP_RSLT_ERR_TRACE_INIT;
+        }
+        else
+        {
+            Cy_GPIO_Pin_FastInit(CYBSP_TRACE_SWO_PORT, CYBSP_TRACE_SWO_PIN,
+                                 CY_GPIO_DM_STRONG_IN_OFF, 0u, P6_4_CPUSS_SWJ_SWO_TDO);
+
+            TPI->CSPSR = 1u;
+            TPI->ACPR  = (trace_hz / CYBSP_TRACE_SWO_BAUD) - 1u;
+            TPI->SPPR  = CYBSP_TRACE_TPIU_NRZ;
+            TPI->FFCR  = CYBSP_TRACE_TPIU_FFCR_BYPASS;
+
+            ITM->LAR = CYBSP_TRACE_CS_UNLOCK;
+            ITM->TCR = (CYBSP_TRACE_ITM_BUS_ID << ITM_TCR_TraceBusID_Pos) | ITM_TCR_SYNCENA_Msk |
+                       ITM_TCR_ITMENA_Msk;
+            // Allow unprivileged code to write to the stimulus ports
+            ITM->TPR  = 0u;
+            ITM->TER |= (1UL << CYBSP_TRACE_ITM_PORT);
+
+            cybsp_trace_swo_ready = true;
+        }
+    }
+    return result;
+}
+
+
+//--------------------------------------------------------------------------------------------------
+// cybsp_trace_swo_send
+//
+// Called with interrupts disabled. Writes up to max_words queued words, stopping as soon as the
+// ITM FIFO is full.
+//--------------------------------------------------------------------------------------------------
+uint32_t cybsp_trace_swo_send(uint32_t max_words)
+{
+    const uint32_t* words = (const uint32_t*)cybsp_trace_buffer;
+    uint32_t        count = 0u;
+
+    // A debugger may take the ITM over, never write to a disabled port
+    if ((0u != (ITM->TCR & ITM_TCR_ITMENA_Msk)) &&
+        (0u != (ITM->TER & (1UL << CYBSP_TRACE_ITM_PORT))))
+    {
+        while ((count < max_words) && (cybsp_trace_sent != (cybsp_trace_next << 2)) &&
+               (0u != ITM->PORT[CYBSP_TRACE_ITM_PORT].u32))
+        {
+            ITM->PORT[CYBSP_TRACE_ITM_PORT].u32 =
+                words[cybsp_trace_sent++ & ((CYBSP_TRACE_BUFFER_RECORDS << 2) - 1u)];
+            count++;
+        }
+    }
+    return count;
+}
+
+
+//--------------------------------------------------------------------------------------------------
+// cybsp_trace_init
+//--------------------------------------------------------------------------------------------------
+cy_rslt_t cybsp_trace_init(cybsp_trace_output_t output)
+{
+    cy_rslt_t result = CY_RSLT_SUCCESS;
+
+    CoreDebug->DEMCR |= CoreDebug_DEMCR_TRCENA_Msk;
+    DWT->CTRL        |= DWT_CTRL_CYCCNTENA_Msk;
+
+    if ((CYBSP_TRACE_OUTPUT_SWO == output) && !cybsp_trace_swo_ready)
+    {
+        result = cybsp_trace_swo_init();
+    }
+
+    if (CY_RSLT_SUCCESS == result)
+    {
+        uint32_t savedIntrStatus = Cy_SysLib_EnterCriticalSection();
+        // Records kept for a RAM export are not streamed
+        cybsp_trace_sent    = cybsp_trace_next << 2;
+        cybsp_trace_dropped = 0u;
+        cybsp_trace_output  = output;
+        Cy_SysLib_ExitCriticalSection(savedIntrStatus);
+        // Lets the decoder pick up the stream and the clock
+        CYBSP_TRACE_EVENT2(CYBSP_TRACE_ID_SYNC, 0u, SystemCoreClock);
+    }
+    return result;
+}
+
+
+//--------------------------------------------------------------------------------------------------
+// cybsp_trace_export
+//--------------------------------------------------------------------------------------------------
+cy_rslt_t cybsp_trace_export(cybsp_trace_write_t write_fn)
+{
+    CY_ASSERT(NULL != write_fn);
+
+    uint32_t             savedIntrStatus = Cy_SysLib_EnterCriticalSection();
+    cybsp_trace_output_t output          = cybsp_trace_output;
+    uint32_t             next            = cybsp_trace_next;
+    cybsp_trace_output = CYBSP_TRACE_OUTPUT_NONE;
+    Cy_SysLib_ExitCriticalSection(savedIntrStatus);
+
+    uint32_t count = (next < CYBSP_TRACE_BUFFER_RECORDS) ? next : CYBSP_TRACE_BUFFER_RECORDS;
+    const cybsp_trace_record_t sync =
+    {
+        .timestamp = DWT->CYCCNT,
+        .header    = ((uint32_t)CYBSP_TRACE_ID_SYNC << 16) | 2u,
+        .arg       = { count, SystemCoreClock }
+    };
+
+    cy_rslt_t result = write_fn(&sync, sizeof(sync));
+    for (uint32_t i = next - count; (CY_RSLT_SUCCESS == result) && (i != next); i++)
+    {
+        result = write_fn(&cybsp_trace_buffer[i & (CYBSP_TRACE_BUFFER_RECORDS - 1u)],
+                          sizeof(cybsp_trace_record_t));
+    }
+
+    cybsp_trace_output = output;
+    return result;
+}
+
+
+//--------------------------------------------------------------------------------------------------
+// cybsp_trace_flush
+//--------------------------------------------------------------------------------------------------
+uint32_t cybsp_trace_flush(void)
+{
+    uint32_t pending = 0u;
+    uint32_t sent    = 1u;
+
+    // One word per critical section, so interrupts are never held off for more than a write
+    while (0u != sent)
+    {
+        uint32_t savedIntrStatus = Cy_SysLib_EnterCriticalSection();
+        sent    = 0u;
+        pending = 0u;
+        if (CYBSP_TRACE_OUTPUT_SWO == cybsp_trace_output)
+        {
+            sent    = cybsp_trace_swo_send(1u);
+            pending = (cybsp_trace_next << 2) - cybsp_trace_sent;
+        }
+        Cy_SysLib_ExitCriticalSection(savedIntrStatus);
+    }
+    return pending;
+}
+
+
+//--------------------------------------------------------------------------------------------------
+// cybsp_trace_get_dropped
+//--------------------------------------------------------------------------------------------------
+uint32_t cybsp_trace_get_dropped(void)
+{
+    return cybsp_trace_dropped;
+}
+
+
+#if defined(__cplusplus)
+}
+#endif
+
+#endif // defined(CYBSP_TRACE)
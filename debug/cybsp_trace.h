@@ -0,0 +1,221 @@
+/***********************************************************************************************//**
+ * \file cybsp_trace.h
+ *
+ * \brief
+ * Binary event trace recorded to RAM or streamed over SWO.
+ *
+ ***************************************************************************************************
+ * \copyright
+ * Copyright 2023 Cypress Semiconductor Corporation (an Infineon company) or
+ * an affiliate of Cypress Semiconductor Corporation
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ **************************************************************************************************/
+
+#pragma once
+
+#include <stddef.h>
+#include <stdint.h>
+#include "cy_result.h"
+#if defined(CYBSP_TRACE)
+#include "cy_device_headers.h"
+#endif
+
+#if defined(__cplusplus)
+extern "C" {
+#endif
+
+/**
+ * \addtogroup group_bsp_trace Event Trace
+ * \{
+ * When CYBSP_TRACE is defined, \ref CYBSP_TRACE_EVENT, \ref CYBSP_TRACE_EVENT1 and
+ * \ref CYBSP_TRACE_EVENT2 record an event ID with up to two argument words and a DWT cycle
+ * timestamp. Without the define the macros expand to nothing, so trace points can stay in
+ * production code.
+ *
+ * Events go to one of two outputs, selected by \ref cybsp_trace_init:
+ * - \ref CYBSP_TRACE_OUTPUT_RAM keeps the last \ref CYBSP_TRACE_BUFFER_RECORDS events in a RAM
+ *   ring, overwriting the oldest. Recording an event takes a few tens of cycles. The ring is sent
+ *   on request with \ref cybsp_trace_export, for example to \ref cybsp_log_write for a UART export.
+ * - \ref CYBSP_TRACE_OUTPUT_SWO streams the events through an ITM stimulus port over SWO on P6.4
+ *   while a debug probe captures it. The same ring queues the events that the ITM FIFO cannot
+ *   take yet: each trace point and \ref cybsp_trace_flush write queued words only while the FIFO
+ *   has space, never waiting for it. When the ring is full the new event is dropped and counted,
+ *   see \ref cybsp_trace_get_dropped. Call \ref cybsp_trace_flush from the idle loop so the queue
+ *   drains between bursts of events.
+ *
+ * Both outputs use the same little-endian stream of \ref cybsp_trace_record_t: the timestamp, a
+ * header word with the event ID in bits 31:16 and the number of valid arguments in bits 1:0, and
+ * two argument words. The stream starts with a \ref CYBSP_TRACE_ID_SYNC record whose arguments
+ * are the number of records that follow (0 for SWO) and SystemCoreClock, so a host script can
+ * convert timestamps to time. The timestamp is the free running cycle counter, which stops while
+ * the CPU sleeps; add a trace point after wakeup where the time spent asleep matters.
+ *
+ * IDs from 0xFF00 are reserved for the BSP. \ref group_bsp_ipc_channel records its doorbells.
+ * FreeRTOS context switches can be traced from FreeRTOSConfig.h with
+ * `#define traceTASK_SWITCHED_IN() CYBSP_TRACE_EVENT1(CYBSP_TRACE_ID_TASK_SWITCH,
+ * (uint32_t)pxCurrentTCB)`.
+ *
+ * \note The SWO output routes P6.4 to the DAP at run time, so it cannot be used together with
+ * \ref CYBSP_UART_RX. design.modus keeps the trace modes disabled for that reason.
+ */
+
+/** Stream header record, see above */
+#define CYBSP_TRACE_ID_SYNC             (0xFFFFu)
+/** IPC doorbell rung, argument: IPC structure */
+#define CYBSP_TRACE_ID_IPC_NOTIFY       (0xFF01u)
+/** IPC doorbell received, argument: IPC structure */
+#define CYBSP_TRACE_ID_IPC_DOORBELL     (0xFF02u)
+/** RTOS context switch, argument: task handle */
+#define CYBSP_TRACE_ID_TASK_SWITCH      (0xFF10u)
+
+#if defined(CYBSP_TRACE)
+
+#if !defined(CYBSP_TRACE_BUFFER_RECORDS)
+/** Number of records kept by \ref CYBSP_TRACE_OUTPUT_RAM, must be a power of two. */
+#define CYBSP_TRACE_BUFFER_RECORDS      (256u)
+#endif
+
+#if !defined(CYBSP_TRACE_ITM_PORT)
+/** ITM stimulus port used by \ref CYBSP_TRACE_OUTPUT_SWO, 0 to 31. */
+#define CYBSP_TRACE_ITM_PORT            (1u)
+#endif
+
+#if !defined(CYBSP_TRACE_SWO_BAUD)
+/** SWO bit rate, must be supported by the debug probe. */
+#define CYBSP_TRACE_SWO_BAUD            (2000000u)
+#endif
+
+/** Output of the recorded events */
+typedef enum
+{
+    CYBSP_TRACE_OUTPUT_NONE,        /**< Events are discarded */
+    CYBSP_TRACE_OUTPUT_RAM,         /**< RAM ring, see \ref cybsp_trace_export */
+    CYBSP_TRACE_OUTPUT_SWO          /**< ITM stimulus port over SWO */
+} cybsp_trace_output_t;
+
+/** One trace record, as stored and streamed */
+typedef struct
+{
+    uint32_t timestamp;     /**< DWT cycle count */
+    uint32_t header;        /**< Event ID in bits 31:16, number of arguments in bits 1:0 */
+    uint32_t arg[2];        /**< Arguments, 0 if unused */
+} cybsp_trace_record_t;
+
+/** Function receiving the exported stream, such as \ref cybsp_log_write */
+typedef cy_rslt_t (*cybsp_trace_write_t)(const void* data, size_t length);
+
+/** Records an event without arguments */
+#define CYBSP_TRACE_EVENT(id)               cybsp_trace_record(((uint32_t)(id) << 16), 0u, 0u)
+/** Records an event with one argument */
+#define CYBSP_TRACE_EVENT1(id, a)           \
+    cybsp_trace_record(((uint32_t)(id) << 16) | 1u, (uint32_t)(a), 0u)
+/** Records an event with two arguments */
+#define CYBSP_TRACE_EVENT2(id, a, b)        \
+    cybsp_trace_record(((uint32_t)(id) << 16) | 2u, (uint32_t)(a), (uint32_t)(b))
+
+/** \cond INTERNAL */
+extern cybsp_trace_output_t cybsp_trace_output;
+extern uint32_t             cybsp_trace_next;
+extern uint32_t             cybsp_trace_sent;
+extern uint32_t             cybsp_trace_dropped;
+extern cybsp_trace_record_t cybsp_trace_buffer[CYBSP_TRACE_BUFFER_RECORDS];
+
+uint32_t cybsp_trace_swo_send(uint32_t max_words);
+/** \endcond */
+
+/**
+ * \brief Records an event. Use the CYBSP_TRACE_EVENT macros instead of calling it directly.
+ * \param header Event ID and argument count
+ * \param arg0   First argument
+ * \param arg1   Second argument
+ */
+__STATIC_FORCEINLINE void cybsp_trace_record(uint32_t header, uint32_t arg0, uint32_t arg1)
+{
+    uint32_t primask = __get_PRIMASK();
+    __disable_irq();
+    uint32_t timestamp = DWT->CYCCNT;
+
+    // For SWO the ring is a queue: words in flight are counted by cybsp_trace_sent and never
+    // overwritten.
+    if ((CYBSP_TRACE_OUTPUT_RAM == cybsp_trace_output) ||
+        ((CYBSP_TRACE_OUTPUT_SWO == cybsp_trace_output) &&
+         (((cybsp_trace_next << 2) - cybsp_trace_sent) < (CYBSP_TRACE_BUFFER_RECORDS << 2))))
+    {
+        cybsp_trace_record_t* record =
+            &cybsp_trace_buffer[cybsp_trace_next++ & (CYBSP_TRACE_BUFFER_RECORDS - 1u)];
+        record->timestamp = timestamp;
+        record->header    = header;
+        record->arg[0]    = arg0;
+        record->arg[1]    = arg1;
+    }
+    else if (CYBSP_TRACE_OUTPUT_SWO == cybsp_trace_output)
+    {
+        cybsp_trace_dropped++;
+    }
+
+    if (CYBSP_TRACE_OUTPUT_SWO == cybsp_trace_output)
+    {
+        (void)cybsp_trace_swo_send(4u);
+    }
+
+    __set_PRIMASK(primask);
+}
+
+/**
+ * \brief Starts the cycle counter and selects the trace output.
+ * For \ref CYBSP_TRACE_OUTPUT_SWO, also allocates a peripheral clock divider for the trace clock,
+ * reserves P6.4 and configures the TPIU for NRZ output at \ref CYBSP_TRACE_SWO_BAUD.
+ * \param output Output of the recorded events
+ * \returns CY_RSLT_SUCCESS if tracing is running, CYBSP_RSLT_ERR_TRACE_INIT if the SWO bit rate
+ *          cannot be generated, otherwise the error from allocating the clock or the pin
+ */
+cy_rslt_t cybsp_trace_init(cybsp_trace_output_t output);
+
+/**
+ * \brief Sends the events in the RAM ring, oldest first, preceded by a sync record.
+ * Recording is paused while the stream is written.
+ * \param write_fn Function receiving the stream
+ * \returns CY_RSLT_SUCCESS, or the first error returned by write_fn
+ */
+cy_rslt_t cybsp_trace_export(cybsp_trace_write_t write_fn);
+
+/**
+ * \brief Writes queued \ref CYBSP_TRACE_OUTPUT_SWO events to the ITM for as long as its FIFO has
+ * space, without waiting for it. Does nothing for the other outputs.
+ * \returns The number of words still queued
+ */
+uint32_t cybsp_trace_flush(void);
+
+/**
+ * \brief Returns the number of \ref CYBSP_TRACE_OUTPUT_SWO events dropped because the ring was
+ * full of events not yet accepted by the ITM.
+ * \returns Dropped events since \ref cybsp_trace_init
+ */
+uint32_t cybsp_trace_get_dropped(void);
+
+#else // if defined(CYBSP_TRACE)
+
+#define CYBSP_TRACE_EVENT(id)
+#define CYBSP_TRACE_EVENT1(id, a)
+#define CYBSP_TRACE_EVENT2(id, a, b)
+
+#endif // defined(CYBSP_TRACE)
+
+/** \} group_bsp_trace */
+
+#ifdef __cplusplus
+}
+#endif // __cplusplus
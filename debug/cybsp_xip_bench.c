@@ -0,0 +1,261 @@
+/***********************************************************************************************//**
+ * \file cybsp_xip_bench.c
+ *
+ * Description:
+ * Read bandwidth benchmark of the memory mapped QSPI flash for each SMIF cache profile.
+ *
+ ***************************************************************************************************
+ * \copyright
+ * Copyright 2023 Cypress Semiconductor Corporation (an Infineon company) or
+ * an affiliate of Cypress Semiconductor Corporation
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ **************************************************************************************************/
+
+#if defined(CYBSP_XIP)
+
+#include <stdbool.h>
+#include "cy_device_headers.h"
+#include "cy_syslib.h"
+#include "system_psoc6.h"
+#include "cy_smif.h"
+#include "cybsp.h"
+#include "cybsp_xip_bench.h"
+
+#if defined(__cplusplus)
+extern "C" {
+#endif
+
+// SMIF cache lines are 16 bytes
+#define CYBSP_XIP_BENCH_LINE_WORDS      (4u)
+#define CYBSP_XIP_BENCH_MIN_LENGTH      (1024u)
+#define CYBSP_XIP_BENCH_RAND_LOADS      (1024u)
+#define CYBSP_XIP_BENCH_CAL_LOADS       (64u)
+#define CYBSP_XIP_BENCH_SEED            (0x2545F491u)
+
+typedef struct
+{
+    uint32_t total;     // Cycles of the whole pass
+    uint32_t load;      // Cycles spent in the loads only
+} cybsp_xip_bench_cycles_t;
+
+static const char* const cybsp_xip_bench_names[CYBSP_XIP_CACHE_PROFILE_COUNT] =
+{
+    "random code",
+    "streaming",
+    "uncached"
+};
+
+// Keeps the loads from being optimized away
+static volatile uint32_t cybsp_xip_bench_sink;
+
+//--------------------------------------------------------------------------------------------------
+// cybsp_xip_bench_pass
+//
+// Performs count loads, walking the words in order or picking one word of a random cache line,
+// optionally invalidating the caches before each load.
+//--------------------------------------------------------------------------------------------------
+static void cybsp_xip_bench_pass(const volatile uint32_t* base, uint32_t mask, bool random,
+                                 bool invalidate, uint32_t count, cybsp_xip_bench_cycles_t* cycles)
+{
+    uint32_t seed = CYBSP_XIP_BENCH_SEED;
+    uint32_t sum  = 0u;
+    uint32_t load = 0u;
+
+    uint32_t savedIntrStatus = Cy_SysLib_EnterCriticalSection();
+    uint32_t start           = DWT->CYCCNT;
+    for (uint32_t i = 0u; i < count; i++)
+    {
+        uint32_t index = i;
+        if (random)
+        {
+            seed  = (seed * 1664525u) + 1013904223u;
+            index = (seed >> 8) & ~(CYBSP_XIP_BENCH_LINE_WORDS - 1u);
+        }
+        if (invalidate)
+        {
+            (void)Cy_SMIF_CacheInvalidate(SMIF0, CY_SMIF_CACHE_BOTH);
+        }
+        uint32_t t0 = DWT->CYCCNT;
+        sum  += base[index & mask];
+        load += DWT->CYCCNT - t0;
+    }
+    cycles->total = DWT->CYCCNT - start;
+    Cy_SysLib_ExitCriticalSection(savedIntrStatus);
+
+    cycles->load         = load;
+    cybsp_xip_bench_sink = sum;
+}
+
+
+//--------------------------------------------------------------------------------------------------
+// cybsp_xip_bench_kbyte_s
+//--------------------------------------------------------------------------------------------------
+static uint32_t cybsp_xip_bench_kbyte_s(uint32_t bytes, uint32_t cycles)
+{
+    return (0u != cycles)
+        ? (uint32_t)(((uint64_t)bytes * (SystemCoreClock / 1000u)) / cycles)
+        : 0u;
+}
+
+
+//--------------------------------------------------------------------------------------------------
+// cybsp_xip_bench_avg
+//
+// Average load cost in 1/256 cycles
+//--------------------------------------------------------------------------------------------------
+static uint32_t cybsp_xip_bench_avg(const cybsp_xip_bench_cycles_t* cycles, uint32_t count)
+{
+    return (uint32_t)(((uint64_t)cycles->load << 8) / count);
+}
+
+
+//--------------------------------------------------------------------------------------------------
+// cybsp_xip_bench_hit_pct
+//--------------------------------------------------------------------------------------------------
+static uint8_t cybsp_xip_bench_hit_pct(uint32_t avg, uint32_t hit, uint32_t miss)
+{
+    uint8_t pct;
+    if ((miss <= hit) || (avg >= miss))
+    {
+        pct = 0u;
+    }
+    else if (avg <= hit)
+    {
+        pct = 100u;
+    }
+    else
+    {
+        pct = (uint8_t)(((miss - avg) * 100u) / (miss - hit));
+    }
+    return pct;
+}
+
+
+//--------------------------------------------------------------------------------------------------
+// cybsp_xip_bench_run
+//--------------------------------------------------------------------------------------------------
+cy_rslt_t cybsp_xip_bench_run(const cybsp_xip_bench_config_t* config,
+                              cybsp_xip_bench_result_t results[CYBSP_XIP_CACHE_PROFILE_COUNT])
+{
+    if ((NULL == config) || (NULL == results))
+    {
+        return CYBSP_RSLT_ERR_XIP_BAD_ARG;
+    }
+    uint32_t addr = (uint32_t)config->region;
+    if ((addr < CYBSP_XIP_START) || (addr >= (CYBSP_XIP_START + CYBSP_XIP_SIZE)) ||
+        (0u != (addr & 3u)) || (config->length < CYBSP_XIP_BENCH_MIN_LENGTH) ||
+        (config->length > (CYBSP_XIP_START + CYBSP_XIP_SIZE - addr)))
+    {
+        return CYBSP_RSLT_ERR_XIP_BAD_ARG;
+    }
+
+    // The walks wrap with a mask, so only the largest power of two within the region is used
+    size_t   length = (config->length < CYBSP_XIP_BENCH_MAX_LENGTH)
+        ? config->length
+        : CYBSP_XIP_BENCH_MAX_LENGTH;
+    uint32_t words  = 1u;
+    while ((words << 1) <= (length / sizeof(uint32_t)))
+    {
+        words <<= 1;
+    }
+    const volatile uint32_t* base = (const volatile uint32_t*)config->region;
+    uint32_t                 mask = words - 1u;
+
+    CoreDebug->DEMCR |= CoreDebug_DEMCR_TRCENA_Msk;
+    DWT->CTRL        |= DWT_CTRL_CYCCNTENA_Msk;
+
+    cybsp_xip_cache_profile_t saved  = cybsp_xip_get_cache_profile();
+    cy_rslt_t                 result = CY_RSLT_SUCCESS;
+    for (uint32_t p = 0u; (CY_RSLT_SUCCESS == result) && (p < CYBSP_XIP_CACHE_PROFILE_COUNT); p++)
+    {
+        cybsp_xip_bench_cycles_t seq, rand, hit, miss;
+
+        (void)cybsp_xip_set_cache_profile((cybsp_xip_cache_profile_t)p);
+        cybsp_xip_bench_pass(base, mask, false, false, words, &seq);
+        (void)cybsp_xip_set_cache_profile((cybsp_xip_cache_profile_t)p);
+        cybsp_xip_bench_pass(base, mask, true, false, CYBSP_XIP_BENCH_RAND_LOADS, &rand);
+
+        // Calibration: repeated loads from one warm line, and loads after invalidating the caches
+        cybsp_xip_bench_pass(base, CYBSP_XIP_BENCH_LINE_WORDS - 1u, false, false,
+                             CYBSP_XIP_BENCH_LINE_WORDS, &hit);
+        cybsp_xip_bench_pass(base, CYBSP_XIP_BENCH_LINE_WORDS - 1u, false, false,
+                             CYBSP_XIP_BENCH_CAL_LOADS, &hit);
+        cybsp_xip_bench_pass(base, mask, true, true, CYBSP_XIP_BENCH_CAL_LOADS, &miss);
+
+        uint32_t hit_avg  = cybsp_xip_bench_avg(&hit, CYBSP_XIP_BENCH_CAL_LOADS);
+        uint32_t miss_avg = cybsp_xip_bench_avg(&miss, CYBSP_XIP_BENCH_CAL_LOADS);
+
+        results[p].seq_kbyte_s  =
+            cybsp_xip_bench_kbyte_s(words * sizeof(uint32_t), seq.total);
+        results[p].rand_kbyte_s =
+            cybsp_xip_bench_kbyte_s(CYBSP_XIP_BENCH_RAND_LOADS * sizeof(uint32_t), rand.total);
+        results[p].seq_hit_pct  =
+            cybsp_xip_bench_hit_pct(cybsp_xip_bench_avg(&seq, words), hit_avg, miss_avg);
+        results[p].rand_hit_pct =
+            cybsp_xip_bench_hit_pct(cybsp_xip_bench_avg(&rand, CYBSP_XIP_BENCH_RAND_LOADS),
+                                    hit_avg, miss_avg);
+        results[p].dma_kbyte_s  = 0u;
+
+        #if defined(CY_USING_HAL)
+        if ((NULL != config->scratch) && (0u != config->scratch_length))
+        {
+            size_t bytes = (config->scratch_length < config->length)
+                ? config->scratch_length
+                : config->length;
+            (void)cybsp_xip_set_cache_profile((cybsp_xip_cache_profile_t)p);
+            uint32_t start = DWT->CYCCNT;
+            result = cybsp_xip_dma_read(config->scratch, config->region, bytes);
+            results[p].dma_kbyte_s =
+                cybsp_xip_bench_kbyte_s((uint32_t)bytes, DWT->CYCCNT - start);
+        }
+        #endif
+    }
+    (void)cybsp_xip_set_cache_profile(saved);
+
+    return result;
+}
+
+
+//--------------------------------------------------------------------------------------------------
+// cybsp_xip_bench_dump
+//--------------------------------------------------------------------------------------------------
+void cybsp_xip_bench_dump(const cybsp_xip_bench_result_t results[CYBSP_XIP_CACHE_PROFILE_COUNT],
+                          cybsp_xip_bench_print_t print_fn)
+{
+    if ((NULL != results) && (NULL != print_fn))
+    {
+        for (uint32_t p = 0u; p < CYBSP_XIP_CACHE_PROFILE_COUNT; p++)
+        {
+            const cybsp_xip_bench_result_t* r = &results[p];
+            (void)print_fn("%-12s seq %3lu.%03lu MB/s (%3u%% hit)  random %3lu.%03lu MB/s "
+                           "(%3u%% hit)  DMA %3lu.%03lu MB/s\r\n",
+                           cybsp_xip_bench_names[p],
+                           (unsigned long)(r->seq_kbyte_s / 1000u),
+                           (unsigned long)(r->seq_kbyte_s % 1000u), (unsigned)r->seq_hit_pct,
+                           (unsigned long)(r->rand_kbyte_s / 1000u),
+                           (unsigned long)(r->rand_kbyte_s % 1000u), (unsigned)r->rand_hit_pct,
+                           (unsigned long)(r->dma_kbyte_s / 1000u),
+                           (unsigned long)(r->dma_kbyte_s % 1000u));
+        }
+    }
+}
+
+
+#if defined(__cplusplus)
+}
+#endif
+
+#endif // defined(CYBSP_XIP)
@@ -0,0 +1,109 @@
+/***********************************************************************************************//**
+ * \file cybsp_xip_bench.h
+ *
+ * \brief
+ * Read bandwidth benchmark of the memory mapped QSPI flash for each SMIF cache profile.
+ *
+ ***************************************************************************************************
+ * \copyright
+ * Copyright 2023 Cypress Semiconductor Corporation (an Infineon company) or
+ * an affiliate of Cypress Semiconductor Corporation
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ **************************************************************************************************/
+
+#pragma once
+
+#include <stddef.h>
+#include <stdint.h>
+#include "cy_result.h"
+#include "cybsp_xip.h"
+
+#if defined(__cplusplus)
+extern "C" {
+#endif
+
+/**
+ * \addtogroup group_bsp_xip_bench XIP Benchmark
+ * \{
+ * Measures the CPU read bandwidth from the memory mapped QSPI flash with sequential and random
+ * access patterns under every \ref cybsp_xip_cache_profile_t, and the bandwidth of
+ * \ref cybsp_xip_dma_read. Timing uses the DWT cycle counter; each pass runs with interrupts
+ * disabled. The active cache profile is restored afterwards.
+ *
+ * SMIF has no cache hit counters, so the hit rate is estimated from the average cost of a load
+ * relative to the cost of a load that always hits and one that always misses, both of which are
+ * calibrated on the same region for each profile. Loads served by prefetching count as hits.
+ *
+ * \note The region should be considerably larger than the SMIF caches (e.g. 64 KB) so the
+ * sequential pass is not served from the cache alone. The passes only walk the first
+ * \ref CYBSP_XIP_BENCH_MAX_LENGTH bytes of a larger region.
+ */
+
+#if defined(CYBSP_XIP)
+
+#if !defined(CYBSP_XIP_BENCH_MAX_LENGTH)
+/** Largest part of the region walked by the CPU passes, in bytes. Bounds the time spent with
+ * interrupts disabled and keeps the cycle counts of a pass from wrapping. */
+#define CYBSP_XIP_BENCH_MAX_LENGTH      (0x40000u)
+#endif
+
+/** Benchmark input, see \ref cybsp_xip_bench_run */
+typedef struct
+{
+    const void* region;         /**< Region in the memory mapped flash to read, word aligned */
+    size_t      length;         /**< Size of the region in bytes */
+    void*       scratch;        /**< SRAM buffer for the DMA pass, may be NULL to skip it */
+    size_t      scratch_length; /**< Size of the scratch buffer in bytes */
+} cybsp_xip_bench_config_t;
+
+/** Results for one cache profile */
+typedef struct
+{
+    uint32_t seq_kbyte_s;       /**< Sequential 32-bit CPU reads, kB/s */
+    uint32_t rand_kbyte_s;      /**< Random 32-bit CPU reads, one per cache line, kB/s */
+    uint32_t dma_kbyte_s;       /**< \ref cybsp_xip_dma_read into the scratch buffer, kB/s */
+    uint8_t  seq_hit_pct;       /**< Estimated cache hit rate of the sequential pass, percent */
+    uint8_t  rand_hit_pct;      /**< Estimated cache hit rate of the random pass, percent */
+} cybsp_xip_bench_result_t;
+
+/** printf compatible function used to print the results */
+typedef int (*cybsp_xip_bench_print_t)(const char* format, ...);
+
+/**
+ * \brief Runs the benchmark for all cache profiles.
+ * \param config  Benchmark input
+ * \param results Filled with one entry per \ref cybsp_xip_cache_profile_t
+ * \returns CY_RSLT_SUCCESS if the benchmark completed, CYBSP_RSLT_ERR_XIP_BAD_ARG if the region is
+ *          not within the memory mapped flash or too small, otherwise the error from the DMA pass
+ */
+cy_rslt_t cybsp_xip_bench_run(const cybsp_xip_bench_config_t* config,
+                              cybsp_xip_bench_result_t results[CYBSP_XIP_CACHE_PROFILE_COUNT]);
+
+/**
+ * \brief Prints the results of \ref cybsp_xip_bench_run in MB/s.
+ * \param results  Results of \ref cybsp_xip_bench_run
+ * \param print_fn printf compatible function used for the output
+ */
+void cybsp_xip_bench_dump(const cybsp_xip_bench_result_t results[CYBSP_XIP_CACHE_PROFILE_COUNT],
+                          cybsp_xip_bench_print_t print_fn);
+
+#endif // defined(CYBSP_XIP)
+
+/** \} group_bsp_xip_bench */
+
+#ifdef __cplusplus
+}
+#endif // __cplusplus
@@ -0,0 +1,294 @@
+/***********************************************************************************************//**
+ * \file cybsp_ipc_channel.c
+ *
+ * Description:
+ * Lock-free descriptor rings between cores with batched IPC doorbell notifications.
+ *
+ ***************************************************************************************************
+ * \copyright
+ * Copyright 2023 Cypress Semiconductor Corporation (an Infineon company) or
+ * an affiliate of Cypress Semiconductor Corporation
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ **************************************************************************************************/
+
+#if defined(CYBSP_IPC_CHANNEL)
+
+#include <stddef.h>
+#include "cy_device_headers.h"
+#include "cy_syslib.h"
+#include "cy_ipc_drv.h"
+#include "cy_sysint.h"
+#include "cybsp.h"
+
+#if defined(__cplusplus)
+extern "C" {
+#endif
+
+#define CYBSP_IPC_RING_MASK     (CYBSP_IPC_RING_SLOTS - 1u)
+
+#if (0u != (CYBSP_IPC_RING_SLOTS & CYBSP_IPC_RING_MASK))
+    #error "CYBSP_IPC_RING_SLOTS must be a power of two"
+#endif
+
+// Channels that receive doorbells on this core
+static cybsp_ipc_channel_t* cybsp_ipc_channels[CYBSP_IPC_CHANNEL_MAX];
+
+//--------------------------------------------------------------------------------------------------
+// cybsp_ipc_ring_init
+//--------------------------------------------------------------------------------------------------
+void cybsp_ipc_ring_init(cybsp_ipc_ring_t* ring)
+{
+    CY_ASSERT(NULL != ring);
+
+    ring->head  = 0u;
+    ring->tail  = 0u;
+    __DMB();
+    ring->magic = CYBSP_IPC_RING_MAGIC;
+}
+
+
+//--------------------------------------------------------------------------------------------------
+// cybsp_ipc_channel_init
+//--------------------------------------------------------------------------------------------------
+cy_rslt_t cybsp_ipc_channel_init(cybsp_ipc_channel_t* channel,
+                                 const cybsp_ipc_channel_config_t* config)
+{
+    if ((NULL == channel) || (NULL == config) || (NULL == config->tx) || (NULL == config->rx) ||
+        (CYBSP_IPC_RING_MAGIC != config->tx->magic) || (CYBSP_IPC_RING_MAGIC != config->rx->magic)
+        || (0u == config->batch))
+    {
+        return CYBSP_RSLT_ERR_IPC_CHANNEL_BAD_ARG;
+    }
+
+    cy_rslt_t result          = CYBSP_RSLT_ERR_IPC_CHANNEL_BAD_ARG;
+    uint32_t  savedIntrStatus = Cy_SysLib_EnterCriticalSection();
+    for (uint32_t i = 0u; i < CYBSP_IPC_CHANNEL_MAX; i++)
+    {
+        if (NULL == cybsp_ipc_channels[i])
+        {
+            channel->config       = *config;
+            channel->reclaim      = config->tx->tail;
+            channel->rx_next      = config->rx->tail;
+            channel->unnotified   = 0u;
+            channel->stats        = (cybsp_ipc_channel_stats_t) { 0u };
+            cybsp_ipc_channels[i] = channel;
+            result                = CY_RSLT_SUCCESS;
+            break;
+        }
+    }
+    Cy_SysLib_ExitCriticalSection(savedIntrStatus);
+
+    if (CY_RSLT_SUCCESS == result)
+    {
+        // Only the notify event of the structure the peer rings us with is of interest
+        IPC_INTR_STRUCT_Type* intr = Cy_IPC_Drv_GetIntrBaseAddr(config->local_intr);
+        uint32_t              mask = Cy_IPC_Drv_GetInterruptMask(intr);
+        Cy_IPC_Drv_SetInterruptMask(intr, Cy_IPC_Drv_ExtractReleaseMask(mask),
+                                    Cy_IPC_Drv_ExtractAcquireMask(mask) |
+                                    (1UL << config->rx_ipc_chan));
+
+        #if (CY_CPU_CORTEX_M4)
+        const cy_stc_sysint_t irq_cfg =
+        {
+            .intrSrc      =
+                (IRQn_Type)((uint32_t)cpuss_interrupts_ipc_0_IRQn + config->local_intr),
+            .intrPriority = config->intr_priority
+        };
+        if (CY_SYSINT_SUCCESS == Cy_SysInt_Init(&irq_cfg, &cybsp_ipc_channel_irq_handler))
+        {
+            NVIC_EnableIRQ(irq_cfg.intrSrc);
+        }
+        else
+        {
+            result = CYBSP_RSLT_ERR_IPC_CHANNEL_BAD_ARG;
+        }
+        #endif
+    }
+
+    return result;
+}
+
+
+//--------------------------------------------------------------------------------------------------
+// cybsp_ipc_channel_send
+//--------------------------------------------------------------------------------------------------
+cy_rslt_t cybsp_ipc_channel_send(cybsp_ipc_channel_t* channel, const cybsp_ipc_desc_t* desc)
+{
+    CY_ASSERT((NULL != channel) && (NULL != desc));
+
+    cybsp_ipc_ring_t* ring = channel->config.tx;
+    uint32_t          head = ring->head;
+
+    // Slots between reclaim and head are owned by the peer or wait to be reclaimed
+    if ((head - channel->reclaim) >= CYBSP_IPC_RING_SLOTS)
+    {
+        channel->stats.full++;
+        return CYBSP_RSLT_ERR_IPC_CHANNEL_FULL;
+    }
+
+    ring->desc[head & CYBSP_IPC_RING_MASK] = *desc;
+    // The descriptor must be visible to the peer before the new head
+    __DMB();
+    ring->head = head + 1u;
+
+    channel->stats.sent++;
+    if (++channel->unnotified >= channel->config.batch)
+    {
+        cybsp_ipc_channel_flush(channel);
+    }
+    return CY_RSLT_SUCCESS;
+}
+
+
+//--------------------------------------------------------------------------------------------------
+// cybsp_ipc_channel_flush
+//--------------------------------------------------------------------------------------------------
+void cybsp_ipc_channel_flush(cybsp_ipc_channel_t* channel)
+{
+    CY_ASSERT(NULL != channel);
+
+    if (0u != channel->unnotified)
+    {
+        channel->unnotified = 0u;
+
+        // The lock stays acquired until the peer acknowledges the doorbell. If it is still held,
+        // the peer has not drained the ring yet and will see the new head when it does.
+        IPC_STRUCT_Type* ipc       = Cy_IPC_Drv_GetIpcBaseAddress(channel->config.tx_ipc_chan);
+        uint32_t         peer_mask = (1UL << channel->config.peer_intr);
+        if (CY_IPC_DRV_SUCCESS == Cy_IPC_Drv_AcquireNotify(ipc, peer_mask))
+        {
+            CYBSP_TRACE_EVENT1(CYBSP_TRACE_ID_IPC_NOTIFY, channel->config.tx_ipc_chan);
+            channel->stats.doorbells++;
+        }
+        else
+        {
+            channel->stats.coalesced++;
+        }
+    }
+}
+
+
+//--------------------------------------------------------------------------------------------------
+// cybsp_ipc_channel_receive
+//--------------------------------------------------------------------------------------------------
+bool cybsp_ipc_channel_receive(cybsp_ipc_channel_t* channel, cybsp_ipc_desc_t* desc)
+{
+    CY_ASSERT((NULL != channel) && (NULL != desc));
+
+    cybsp_ipc_ring_t* ring = channel->config.rx;
+    if (ring->head == channel->rx_next)
+    {
+        return false;
+    }
+
+    // Read the descriptor only after observing the head that published it
+    __DMB();
+    *desc = ring->desc[channel->rx_next & CYBSP_IPC_RING_MASK];
+    channel->rx_next++;
+    channel->stats.received++;
+    return true;
+}
+
+
+//--------------------------------------------------------------------------------------------------
+// cybsp_ipc_channel_release
+//--------------------------------------------------------------------------------------------------
+void cybsp_ipc_channel_release(cybsp_ipc_channel_t* channel, uint32_t count)
+{
+    CY_ASSERT(NULL != channel);
+
+    cybsp_ipc_ring_t* ring = channel->config.rx;
+    uint32_t          tail = ring->tail;
+    CY_ASSERT(count <= (channel->rx_next - tail));
+
+    // All accesses to the released buffers must complete before the peer may reuse them
+    __DMB();
+    ring->tail = tail + count;
+}
+
+
+//--------------------------------------------------------------------------------------------------
+// cybsp_ipc_channel_reclaim
+//--------------------------------------------------------------------------------------------------
+bool cybsp_ipc_channel_reclaim(cybsp_ipc_channel_t* channel, cybsp_ipc_desc_t* desc)
+{
+    CY_ASSERT((NULL != channel) && (NULL != desc));
+
+    cybsp_ipc_ring_t* ring = channel->config.tx;
+    if (ring->tail == channel->reclaim)
+    {
+        return false;
+    }
+
+    __DMB();
+    *desc = ring->desc[channel->reclaim & CYBSP_IPC_RING_MASK];
+    channel->reclaim++;
+    return true;
+}
+
+
+//--------------------------------------------------------------------------------------------------
+// cybsp_ipc_channel_irq_handler
+//--------------------------------------------------------------------------------------------------
+CYBSP_RAMFUNC_BEGIN
+void cybsp_ipc_channel_irq_handler(void)
+{
+    for (uint32_t i = 0u; i < CYBSP_IPC_CHANNEL_MAX; i++)
+    {
+        cybsp_ipc_channel_t* channel = cybsp_ipc_channels[i];
+        if (NULL == channel)
+        {
+            continue;
+        }
+
+        IPC_INTR_STRUCT_Type* intr   = Cy_IPC_Drv_GetIntrBaseAddr(channel->config.local_intr);
+        uint32_t              notify =
+            Cy_IPC_Drv_ExtractAcquireMask(Cy_IPC_Drv_GetInterruptStatusMasked(intr));
+        uint32_t              mask   = (1UL << channel->config.rx_ipc_chan);
+
+        if (0u != (notify & mask))
+        {
+            CYBSP_TRACE_EVENT1(CYBSP_TRACE_ID_IPC_DOORBELL, channel->config.rx_ipc_chan);
+            // Acknowledge before draining: anything the peer publishes from now on either rings a
+            // new doorbell or is already visible to the callback below.
+            Cy_IPC_Drv_ClearInterrupt(intr, CY_IPC_NO_NOTIFICATION, mask);
+            Cy_IPC_Drv_LockRelease(Cy_IPC_Drv_GetIpcBaseAddress(channel->config.rx_ipc_chan),
+                                   CY_IPC_NO_NOTIFICATION);
+            if (NULL != channel->config.callback)
+            {
+                channel->config.callback(channel->config.callback_arg);
+            }
+        }
+    }
+}
+CYBSP_RAMFUNC_END
+
+
+//--------------------------------------------------------------------------------------------------
+// cybsp_ipc_channel_get_stats
+//--------------------------------------------------------------------------------------------------
+const cybsp_ipc_channel_stats_t* cybsp_ipc_channel_get_stats(const cybsp_ipc_channel_t* channel)
+{
+    CY_ASSERT(NULL != channel);
+    return &channel->stats;
+}
+
+
+#if defined(__cplusplus)
+}
+#endif
+
+#endif // defined(CYBSP_IPC_CHANNEL)
@@ -0,0 +1,217 @@
+/***********************************************************************************************//**
+ * \file cybsp_ipc_channel.h
+ *
+ * \brief
+ * Zero-copy inter-core channel: lock-free descriptor rings in shared SRAM with IPC doorbells.
+ *
+ ***************************************************************************************************
+ * \copyright
+ * Copyright 2023 Cypress Semiconductor Corporation (an Infineon company) or
+ * an affiliate of Cypress Semiconductor Corporation
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ **************************************************************************************************/
+
+#pragma once
+
+#include <stdbool.h>
+#include <stdint.h>
+#include "cy_result.h"
+#include "cy_syslib.h"
+#include "cybsp_sharedmem.h"
+
+#if defined(__cplusplus)
+extern "C" {
+#endif
+
+/**
+ * \addtogroup group_bsp_ipc_channel IPC Channel
+ * \{
+ * When CYBSP_IPC_CHANNEL is defined, the BSP provides channels between the cores. A channel
+ * connects two cores with one single-producer/single-consumer ring per direction. The rings only
+ * carry small descriptors that point at packet buffers in shared SRAM, so payloads are never
+ * copied. The producer publishes descriptors by advancing the ring head; the consumer hands buffers
+ * back by advancing the ring tail once it is done with them, and the producer reclaims them from
+ * there. Neither side takes a lock.
+ *
+ * IPC interrupts are only used as doorbells. A doorbell is rung after
+ * \ref cybsp_ipc_channel_config_t::batch descriptors or on \ref cybsp_ipc_channel_flush, and is
+ * skipped entirely while a previous doorbell has not been serviced yet, since the consumer drains
+ * everything published before it acknowledges the doorbell.
+ *
+ * The rings must be at an address both images agree on and must not be initialized by either
+ * startup code. Declare them with \ref CYBSP_IPC_SHARED, which places them in the shared SRAM
+ * region. Apart from connecting the doorbell interrupt, which \ref cybsp_ipc_channel_init does
+ * on the CM4, the code has no core specific parts, so a network processor image built from
+ * source can use the same files for the other end by routing its IPC interrupt to
+ * \ref cybsp_ipc_channel_irq_handler.
+ *
+ * \note The CM4 has no data cache, so no cache maintenance is needed on the shared memory.
+ */
+
+#if defined(CYBSP_IPC_CHANNEL)
+
+#if !defined(CYBSP_IPC_RING_SLOTS)
+/** Number of descriptors per ring, must be a power of two. */
+#define CYBSP_IPC_RING_SLOTS        (32u)
+#endif
+
+#if !defined(CYBSP_IPC_CHANNEL_MAX)
+/** Maximum number of channels that can receive doorbells at the same time on one core. */
+#define CYBSP_IPC_CHANNEL_MAX       (2u)
+#endif
+
+#if !defined(CYBSP_IPC_SHARED)
+/** Placement of the shared rings and buffers, see \ref group_bsp_sharedmem */
+#define CYBSP_IPC_SHARED            CYBSP_SECTION_SHAREDMEM
+#endif
+
+/** Identifies an initialized ring, see \ref cybsp_ipc_ring_init */
+#define CYBSP_IPC_RING_MAGIC        (0x49504352u)
+
+/** Buffer descriptor carried by the rings */
+typedef struct
+{
+    uint32_t addr;      /**< Buffer address in shared SRAM */
+    uint32_t length;    /**< Number of valid bytes in the buffer */
+    uint32_t cookie;    /**< Opaque value for the producer, returned on reclaim */
+    uint32_t flags;     /**< Application defined flags */
+} cybsp_ipc_desc_t;
+
+/** Single-producer/single-consumer descriptor ring. Lives in shared SRAM. */
+typedef struct
+{
+    uint32_t            magic;                      /**< \ref CYBSP_IPC_RING_MAGIC when valid */
+    volatile uint32_t   head;                       /**< Next slot to publish, producer only */
+    volatile uint32_t   tail;                       /**< Next slot to hand back, consumer only */
+    cybsp_ipc_desc_t    desc[CYBSP_IPC_RING_SLOTS]; /**< Descriptor slots */
+} cybsp_ipc_ring_t;
+
+/** Called from the doorbell interrupt. Drain the channel with \ref cybsp_ipc_channel_receive. */
+typedef void (* cybsp_ipc_channel_callback_t)(void* arg);
+
+/** Configuration of a channel endpoint */
+typedef struct
+{
+    cybsp_ipc_ring_t*               tx;             /**< Ring this core produces on */
+    cybsp_ipc_ring_t*               rx;             /**< Ring this core consumes from */
+    uint32_t                        tx_ipc_chan;    /**< IPC structure used to ring the peer */
+    uint32_t                        rx_ipc_chan;    /**< IPC structure the peer rings this core */
+    uint32_t                        peer_intr;      /**< IPC interrupt serviced by the peer */
+    uint32_t                        local_intr;     /**< IPC interrupt serviced by this core */
+    uint32_t                        intr_priority;  /**< NVIC priority of the doorbell interrupt */
+    uint32_t                        batch;          /**< Descriptors per doorbell, at least 1 */
+    cybsp_ipc_channel_callback_t    callback;       /**< Doorbell callback, may be NULL */
+    void*                           callback_arg;   /**< Argument passed to the callback */
+} cybsp_ipc_channel_config_t;
+
+/** Channel statistics, see \ref cybsp_ipc_channel_get_stats */
+typedef struct
+{
+    uint32_t sent;          /**< Descriptors published */
+    uint32_t received;      /**< Descriptors received */
+    uint32_t doorbells;     /**< Doorbells rung */
+    uint32_t coalesced;     /**< Doorbells skipped because one was still pending */
+    uint32_t full;          /**< Sends rejected because the ring was full */
+} cybsp_ipc_channel_stats_t;
+
+/** Channel endpoint. Local to one core; the fields are managed by the BSP. */
+typedef struct
+{
+    cybsp_ipc_channel_config_t  config;         /**< Configuration */
+    uint32_t                    reclaim;        /**< Next tx slot to reclaim */
+    uint32_t                    rx_next;        /**< Next rx slot to receive */
+    uint32_t                    unnotified;     /**< Published since the last doorbell */
+    cybsp_ipc_channel_stats_t   stats;          /**< Statistics */
+} cybsp_ipc_channel_t;
+
+/**
+ * \brief Initializes a ring. Called by exactly one of the two cores before the channel is used.
+ * \param ring Ring to initialize
+ */
+void cybsp_ipc_ring_init(cybsp_ipc_ring_t* ring);
+
+/**
+ * \brief Initializes a channel endpoint and enables its doorbell interrupt.
+ * \param channel Endpoint object, must stay valid while the channel is in use
+ * \param config  Endpoint configuration, copied
+ * \returns CY_RSLT_SUCCESS if the channel was initialized, CYBSP_RSLT_ERR_IPC_CHANNEL_BAD_ARG if
+ *          the configuration is invalid, the rings are not initialized or no channel slot is left
+ */
+cy_rslt_t cybsp_ipc_channel_init(cybsp_ipc_channel_t* channel,
+                                 const cybsp_ipc_channel_config_t* config);
+
+/**
+ * \brief Publishes a buffer descriptor to the peer.
+ * The buffer belongs to the peer until it is returned by \ref cybsp_ipc_channel_reclaim.
+ * \param channel Channel endpoint
+ * \param desc    Descriptor to publish
+ * \returns CY_RSLT_SUCCESS if the descriptor was published, CYBSP_RSLT_ERR_IPC_CHANNEL_FULL if
+ *          no slot is free (reclaim completed buffers first)
+ */
+cy_rslt_t cybsp_ipc_channel_send(cybsp_ipc_channel_t* channel, const cybsp_ipc_desc_t* desc);
+
+/**
+ * \brief Rings the peer's doorbell for descriptors published since the last doorbell.
+ * \param channel Channel endpoint
+ */
+void cybsp_ipc_channel_flush(cybsp_ipc_channel_t* channel);
+
+/**
+ * \brief Returns the next descriptor published by the peer.
+ * The buffer belongs to this core until it is handed back with \ref cybsp_ipc_channel_release.
+ * \param channel Channel endpoint
+ * \param desc    Filled with the descriptor
+ * \returns true if a descriptor was received, false if the ring is empty
+ */
+bool cybsp_ipc_channel_receive(cybsp_ipc_channel_t* channel, cybsp_ipc_desc_t* desc);
+
+/**
+ * \brief Hands the oldest received buffers back to the peer.
+ * Buffers are handed back in the order they were received.
+ * \param channel Channel endpoint
+ * \param count   Number of buffers to hand back, at most the number received and not released
+ */
+void cybsp_ipc_channel_release(cybsp_ipc_channel_t* channel, uint32_t count);
+
+/**
+ * \brief Returns the next buffer the peer has handed back.
+ * \param channel Channel endpoint
+ * \param desc    Filled with the descriptor that was originally sent
+ * \returns true if a buffer was reclaimed, false if none is pending
+ */
+bool cybsp_ipc_channel_reclaim(cybsp_ipc_channel_t* channel, cybsp_ipc_desc_t* desc);
+
+/**
+ * \brief Doorbell interrupt handler shared by all channels.
+ * Installed by \ref cybsp_ipc_channel_init on the CM4. Other cores call it from the handler of
+ * their IPC interrupt.
+ */
+void cybsp_ipc_channel_irq_handler(void);
+
+/**
+ * \brief Returns the channel statistics.
+ * \param channel Channel endpoint
+ * \returns Pointer to the statistics
+ */
+const cybsp_ipc_channel_stats_t* cybsp_ipc_channel_get_stats(const cybsp_ipc_channel_t* channel);
+
+#endif // defined(CYBSP_IPC_CHANNEL)
+
+/** \} group_bsp_ipc_channel */
+
+#ifdef __cplusplus
+}
+#endif // __cplusplus
@@ -0,0 +1,230 @@
+/***********************************************************************************************//**
+ * \file cybsp_ipc_job.c
+ *
+ * Description:
+ * Submitting and worker side of the inter-core job queue.
+ *
+ ***************************************************************************************************
+ * \copyright
+ * Copyright 2023 Cypress Semiconductor Corporation (an Infineon company) or
+ * an affiliate of Cypress Semiconductor Corporation
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ **************************************************************************************************/
+
+#if defined(CYBSP_IPC_JOB)
+
+#include <stddef.h>
+#include "cy_device_headers.h"
+#include "cy_syslib.h"
+#include "cybsp.h"
+#include "cybsp_ipc_job.h"
+
+#if defined(__cplusplus)
+extern "C" {
+#endif
+
+// Each core is either the submitting side or the worker, so both share one channel object
+static cybsp_ipc_channel_t            cybsp_ipc_job_channel;
+static cybsp_ipc_job_stats_t          cybsp_ipc_job_stats;
+static const cybsp_ipc_job_handler_t* cybsp_ipc_job_handlers;
+static uint32_t                       cybsp_ipc_job_handler_count = 0u;
+
+//--------------------------------------------------------------------------------------------------
+// cybsp_ipc_job_now
+//--------------------------------------------------------------------------------------------------
+static inline uint32_t cybsp_ipc_job_now(void)
+{
+    #if (CY_CPU_CORTEX_M4)
+    return DWT->CYCCNT;
+    #else
+    // The CM0+ has no cycle counter; jobs are only timed on the CM4
+    return 0u;
+    #endif
+}
+
+
+//--------------------------------------------------------------------------------------------------
+// cybsp_ipc_job_complete
+//
+// Doorbell callback of the submitting side
+//--------------------------------------------------------------------------------------------------
+static void cybsp_ipc_job_complete(void* arg)
+{
+    CY_UNUSED_PARAMETER(arg);
+
+    cybsp_ipc_desc_t desc;
+    while (cybsp_ipc_channel_receive(&cybsp_ipc_job_channel, &desc))
+    {
+        cybsp_ipc_job_t* job = (cybsp_ipc_job_t*)desc.addr;
+        cybsp_ipc_channel_release(&cybsp_ipc_job_channel, 1u);
+
+        job->latency_cycles = cybsp_ipc_job_now() - job->submit_cycles;
+        cybsp_ipc_job_stats.completed++;
+        if (CY_RSLT_SUCCESS != job->rslt)
+        {
+            cybsp_ipc_job_stats.failed++;
+        }
+        if (job->latency_cycles > cybsp_ipc_job_stats.max_latency_cycles)
+        {
+            cybsp_ipc_job_stats.max_latency_cycles = job->latency_cycles;
+        }
+
+        if (NULL != job->callback)
+        {
+            job->callback(job, job->callback_arg);
+        }
+    }
+}
+
+
+//--------------------------------------------------------------------------------------------------
+// cybsp_ipc_job_init
+//--------------------------------------------------------------------------------------------------
+cy_rslt_t cybsp_ipc_job_init(const cybsp_ipc_channel_config_t* config)
+{
+    if (NULL == config)
+    {
+        return CYBSP_RSLT_ERR_IPC_CHANNEL_BAD_ARG;
+    }
+
+    #if (CY_CPU_CORTEX_M4)
+    CoreDebug->DEMCR |= CoreDebug_DEMCR_TRCENA_Msk;
+    DWT->CTRL        |= DWT_CTRL_CYCCNTENA_Msk;
+    #endif
+
+    cybsp_ipc_channel_config_t channel_config = *config;
+    channel_config.callback     = cybsp_ipc_job_complete;
+    channel_config.callback_arg = NULL;
+    return cybsp_ipc_channel_init(&cybsp_ipc_job_channel, &channel_config);
+}
+
+
+//--------------------------------------------------------------------------------------------------
+// cybsp_ipc_job_submit
+//--------------------------------------------------------------------------------------------------
+cy_rslt_t cybsp_ipc_job_submit(cybsp_ipc_job_t* job)
+{
+    CY_ASSERT(NULL != job);
+
+    cybsp_ipc_desc_t desc =
+    {
+        .addr   = (uint32_t)job,
+        .length = sizeof(*job),
+        .cookie = 0u,
+        .flags  = 0u
+    };
+
+    job->state         = CYBSP_IPC_JOB_STATE_PENDING;
+    job->rslt          = CY_RSLT_SUCCESS;
+    job->submit_cycles = cybsp_ipc_job_now();
+
+    // Jobs may be submitted from several tasks, the ring has a single producer
+    uint32_t savedIntrStatus = Cy_SysLib_EnterCriticalSection();
+    cybsp_ipc_desc_t done;
+    while (cybsp_ipc_channel_reclaim(&cybsp_ipc_job_channel, &done))
+    {
+        // Request slots are handed back once the worker has picked the job up
+    }
+    cy_rslt_t result = cybsp_ipc_channel_send(&cybsp_ipc_job_channel, &desc);
+    if (CY_RSLT_SUCCESS == result)
+    {
+        cybsp_ipc_job_stats.submitted++;
+        cybsp_ipc_channel_flush(&cybsp_ipc_job_channel);
+    }
+    Cy_SysLib_ExitCriticalSection(savedIntrStatus);
+
+    return result;
+}
+
+
+//--------------------------------------------------------------------------------------------------
+// cybsp_ipc_job_get_stats
+//--------------------------------------------------------------------------------------------------
+void cybsp_ipc_job_get_stats(cybsp_ipc_job_stats_t* stats)
+{
+    CY_ASSERT(NULL != stats);
+
+    uint32_t savedIntrStatus = Cy_SysLib_EnterCriticalSection();
+    *stats = cybsp_ipc_job_stats;
+    Cy_SysLib_ExitCriticalSection(savedIntrStatus);
+}
+
+
+//--------------------------------------------------------------------------------------------------
+// cybsp_ipc_job_worker_init
+//--------------------------------------------------------------------------------------------------
+cy_rslt_t cybsp_ipc_job_worker_init(const cybsp_ipc_channel_config_t* config,
+                                    const cybsp_ipc_job_handler_t* handlers, uint32_t count)
+{
+    if ((NULL == config) || ((NULL == handlers) && (0u != count)))
+    {
+        return CYBSP_RSLT_ERR_IPC_CHANNEL_BAD_ARG;
+    }
+
+    cybsp_ipc_job_handlers      = handlers;
+    cybsp_ipc_job_handler_count = count;
+    return cybsp_ipc_channel_init(&cybsp_ipc_job_channel, config);
+}
+
+
+//--------------------------------------------------------------------------------------------------
+// cybsp_ipc_job_worker_poll
+//--------------------------------------------------------------------------------------------------
+uint32_t cybsp_ipc_job_worker_poll(void)
+{
+    uint32_t         count = 0u;
+    cybsp_ipc_desc_t desc;
+
+    while (cybsp_ipc_channel_receive(&cybsp_ipc_job_channel, &desc))
+    {
+        cybsp_ipc_job_t*        job     = (cybsp_ipc_job_t*)desc.addr;
+        cybsp_ipc_job_handler_t handler = (job->type < cybsp_ipc_job_handler_count)
+            ? cybsp_ipc_job_handlers[job->type]
+            : NULL;
+        if (NULL != handler)
+        {
+            job->rslt = handler(job);
+        }
+        else
+        {
+            job->rslt = CYBSP_RSLT_ERR_IPC_JOB_TYPE;
+        }
+        job->state = CYBSP_IPC_JOB_STATE_DONE;
+        count++;
+
+        // The submitting core releases completions from its doorbell interrupt, so a full ring
+        // only needs a doorbell and a short wait.
+        cybsp_ipc_desc_t done;
+        while (CY_RSLT_SUCCESS != cybsp_ipc_channel_send(&cybsp_ipc_job_channel, &desc))
+        {
+            cybsp_ipc_channel_flush(&cybsp_ipc_job_channel);
+            while (cybsp_ipc_channel_reclaim(&cybsp_ipc_job_channel, &done))
+            {
+            }
+        }
+        cybsp_ipc_channel_release(&cybsp_ipc_job_channel, 1u);
+    }
+
+    cybsp_ipc_channel_flush(&cybsp_ipc_job_channel);
+    return count;
+}
+
+
+#if defined(__cplusplus)
+}
+#endif
+
+#endif // defined(CYBSP_IPC_JOB)
@@ -0,0 +1,149 @@
+/***********************************************************************************************//**
+ * \file cybsp_ipc_job.h
+ *
+ * \brief
+ * Job queue for running compute work on the other core, built on an IPC channel.
+ *
+ ***************************************************************************************************
+ * \copyright
+ * Copyright 2023 Cypress Semiconductor Corporation (an Infineon company) or
+ * an affiliate of Cypress Semiconductor Corporation
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ **************************************************************************************************/
+
+#pragma once
+
+#include <stdint.h>
+#include "cy_result.h"
+#include "cybsp_ipc_channel.h"
+
+#if defined(__cplusplus)
+extern "C" {
+#endif
+
+/**
+ * \addtogroup group_bsp_ipc_job IPC Job Queue
+ * \{
+ * When CYBSP_IPC_JOB (which requires CYBSP_IPC_CHANNEL) is defined, the CM4 can hand small compute
+ * jobs (CRC, filtering, compression) to a worker on the other core. A job is a \ref cybsp_ipc_job_t
+ * in shared SRAM that names a job type and its input and output buffers. \ref cybsp_ipc_job_submit
+ * publishes it on an \ref group_bsp_ipc_channel "IPC channel"; the worker runs the handler
+ * registered for the type and sends the job back, and the CM4 calls the completion callback of the
+ * job from the doorbell interrupt together with the time from submission to completion.
+ *
+ * The worker side is part of the same files: a CM0+ image built from source calls
+ * \ref cybsp_ipc_job_worker_init and then \ref cybsp_ipc_job_worker_poll from its main loop, after
+ * each doorbell. The prebuilt CM0+ images selected by BSP_COMPONENTS (CM0P_SLEEP, and the SCL
+ * network processor image) do not contain a worker; the CM0+ project that replaces them must
+ * provide the Wi-Fi functionality itself if the application needs it.
+ *
+ * Jobs, their buffers and the channel rings must be in shared SRAM (\ref CYBSP_IPC_SHARED). Job
+ * handlers run to completion one at a time on the worker.
+ */
+
+#if defined(CYBSP_IPC_JOB)
+
+#if !defined(CYBSP_IPC_CHANNEL)
+    #error "CYBSP_IPC_JOB requires CYBSP_IPC_CHANNEL"
+#endif
+
+/** The job is queued or running on the worker */
+#define CYBSP_IPC_JOB_STATE_PENDING     (0u)
+/** The job has completed, see \ref cybsp_ipc_job_t::rslt */
+#define CYBSP_IPC_JOB_STATE_DONE        (1u)
+
+typedef struct cybsp_ipc_job cybsp_ipc_job_t;
+
+/** Called on the submitting core when a job has completed, from the doorbell interrupt. */
+typedef void (* cybsp_ipc_job_callback_t)(cybsp_ipc_job_t* job, void* arg);
+
+/** Runs a job on the worker. Returns the result stored in \ref cybsp_ipc_job_t::rslt. */
+typedef cy_rslt_t (* cybsp_ipc_job_handler_t)(cybsp_ipc_job_t* job);
+
+/** A job. Lives in shared SRAM until its completion callback has run. */
+struct cybsp_ipc_job
+{
+    uint32_t                    type;           /**< Index into the handler table of the worker */
+    const void*                 input;          /**< Input buffer */
+    uint32_t                    input_length;   /**< Size of the input in bytes */
+    void*                       output;         /**< Output buffer, may be NULL */
+    uint32_t                    output_length;  /**< Size of the output buffer in bytes */
+    uint32_t                    result;         /**< Result word set by the handler (e.g. a CRC) */
+    cy_rslt_t                   rslt;           /**< Status set by the worker */
+    volatile uint32_t           state;          /**< CYBSP_IPC_JOB_STATE_* */
+    cybsp_ipc_job_callback_t    callback;       /**< Completion callback, may be NULL */
+    void*                       callback_arg;   /**< Argument passed to the callback */
+    uint32_t                    submit_cycles;  /**< CM4 cycle count at submission, BSP managed */
+    uint32_t                    latency_cycles; /**< CM4 cycles from submission to completion */
+};
+
+/** Job queue statistics of the submitting core, see \ref cybsp_ipc_job_get_stats */
+typedef struct
+{
+    uint32_t submitted;             /**< Jobs submitted */
+    uint32_t completed;             /**< Jobs completed */
+    uint32_t failed;                /**< Completed jobs whose result was not CY_RSLT_SUCCESS */
+    uint32_t max_latency_cycles;    /**< Longest time from submission to completion */
+} cybsp_ipc_job_stats_t;
+
+/**
+ * \brief Initializes the job queue on the submitting core.
+ * The callback fields of the configuration are replaced by the job queue.
+ * \param config Channel configuration, rings initialized by \ref cybsp_ipc_ring_init
+ * \returns The result of \ref cybsp_ipc_channel_init
+ */
+cy_rslt_t cybsp_ipc_job_init(const cybsp_ipc_channel_config_t* config);
+
+/**
+ * \brief Submits a job to the worker.
+ * The fields type to callback_arg must be set; the job belongs to the job queue until its
+ * completion callback runs or its state reads \ref CYBSP_IPC_JOB_STATE_DONE.
+ * \param job Job in shared SRAM
+ * \returns CY_RSLT_SUCCESS if the job was queued, CYBSP_RSLT_ERR_IPC_CHANNEL_FULL if too many
+ *          jobs are outstanding
+ */
+cy_rslt_t cybsp_ipc_job_submit(cybsp_ipc_job_t* job);
+
+/**
+ * \brief Returns the job queue statistics.
+ * \param stats Filled with the statistics
+ */
+void cybsp_ipc_job_get_stats(cybsp_ipc_job_stats_t* stats);
+
+/**
+ * \brief Initializes the worker. Called on the worker core.
+ * \param config   Channel configuration matching the submitting core, with the rings swapped
+ * \param handlers Handler per job type, must stay valid
+ * \param count    Number of entries in handlers
+ * \returns The result of \ref cybsp_ipc_channel_init
+ */
+cy_rslt_t cybsp_ipc_job_worker_init(const cybsp_ipc_channel_config_t* config,
+                                    const cybsp_ipc_job_handler_t* handlers, uint32_t count);
+
+/**
+ * \brief Runs all queued jobs and sends them back. Called on the worker core.
+ * Jobs of a type without a handler complete with CYBSP_RSLT_ERR_IPC_JOB_TYPE.
+ * \returns The number of jobs that were run
+ */
+uint32_t cybsp_ipc_job_worker_poll(void);
+
+#endif // defined(CYBSP_IPC_JOB)
+
+/** \} group_bsp_ipc_job */
+
+#ifdef __cplusplus
+}
+#endif // __cplusplus
@@ -0,0 +1,487 @@
+/***********************************************************************************************//**
+ * \file cybsp_logstore.c
+ *
+ * Description:
+ * Wear-leveled, log-structured key/value store in the emulated EEPROM flash region.
+ *
+ ***************************************************************************************************
+ * \copyright
+ * Copyright 2023 Cypress Semiconductor Corporation (an Infineon company) or
+ * an affiliate of Cypress Semiconductor Corporation
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ **************************************************************************************************/
+
+#if defined(CYBSP_LOGSTORE)
+
+#include <stdbool.h>
+#include <stddef.h>
+#include <string.h>
+#include "cy_syslib.h"
+#include "cy_syspm.h"
+#include "cy_flash.h"
+#include "cybsp.h"
+
+#if defined(__cplusplus)
+extern "C" {
+#endif
+
+#if defined(__APPLE__) && defined(__clang__)
+    #error "CYBSP_LOGSTORE needs the .cy_em_eeprom section, which this toolchain does not place"
+#endif
+
+#define CYBSP_LOGSTORE_ROW_SIZE     (CY_FLASH_SIZEOF_ROW)
+#define CYBSP_LOGSTORE_ROWS         (CYBSP_LOGSTORE_SIZE / CYBSP_LOGSTORE_ROW_SIZE)
+#define CYBSP_LOGSTORE_HDR_SIZE     (16u)
+#define CYBSP_LOGSTORE_PAYLOAD      (CYBSP_LOGSTORE_ROW_SIZE - CYBSP_LOGSTORE_HDR_SIZE)
+#define CYBSP_LOGSTORE_REC_HDR_SIZE (4u)
+#define CYBSP_LOGSTORE_MAGIC        (0x4C4F4731u)
+
+#if ((CYBSP_LOGSTORE_SIZE % CYBSP_LOGSTORE_ROW_SIZE) != 0u) || (CYBSP_LOGSTORE_ROWS < 3u) || \
+    (CYBSP_LOGSTORE_SIZE > 0x8000u)
+    #error "CYBSP_LOGSTORE_SIZE must be a multiple of the flash row size between 3 rows and 32 KB"
+#endif
+
+typedef struct
+{
+    uint32_t magic;                             // CYBSP_LOGSTORE_MAGIC
+    uint32_t seq;                               // Increments with every row written
+    uint16_t used;                              // Bytes of payload in use
+    uint16_t reserved;
+    uint32_t crc;                               // Over seq, used and the used payload
+    uint8_t  payload[CYBSP_LOGSTORE_PAYLOAD];   // Records, each padded to 4 bytes
+} cybsp_logstore_row_t;
+
+typedef struct
+{
+    uint16_t key;
+    uint16_t length;                            // 0 for a removal
+} cybsp_logstore_rec_t;
+
+CY_SECTION(".cy_em_eeprom") CY_ALIGN(CY_FLASH_SIZEOF_ROW)
+static const uint8_t cybsp_logstore_area[CYBSP_LOGSTORE_SIZE] = { 0u };
+
+// Read through a volatile pointer so the compiler cannot fold the initializer of the area
+static const uint8_t* volatile cybsp_logstore_base = cybsp_logstore_area;
+
+// Sequence number of each valid row, 0 for free rows. cybsp_logstore_head is always free.
+static uint32_t               cybsp_logstore_seq[CYBSP_LOGSTORE_ROWS];
+static uint32_t               cybsp_logstore_head;
+static uint32_t               cybsp_logstore_next_seq;
+// Write-back buffer and the image of the row being written
+static uint32_t               cybsp_logstore_buffer[CYBSP_LOGSTORE_PAYLOAD / sizeof(uint32_t)];
+static uint32_t               cybsp_logstore_used;
+// Set when records were buffered since the last flush attempt, so deep sleep entries do not keep
+// retrying a flush that already failed
+static bool                   cybsp_logstore_pending;
+static cybsp_logstore_row_t   cybsp_logstore_image;
+static cybsp_logstore_stats_t cybsp_logstore_stats;
+
+//--------------------------------------------------------------------------------------------------
+// cybsp_logstore_crc
+//--------------------------------------------------------------------------------------------------
+static uint32_t cybsp_logstore_crc(uint32_t crc, const uint8_t* data, uint32_t length)
+{
+    // CRC-32 (IEEE 802.3), one nibble at a time
+    static const uint32_t table[16] =
+    {
+        0x00000000u, 0x1DB71064u, 0x3B6E20C8u, 0x26D930ACu, 0x76DC4190u, 0x6B6B51F4u,
+        0x4DB26158u, 0x5005713Cu, 0xEDB88320u, 0xF00F9344u, 0xD6D6A3E8u, 0xCB61B38Cu,
+        0x9B64C2B0u, 0x86D3D2D4u, 0xA00AE278u, 0xBDBDF21Cu
+    };
+
+    for (uint32_t i = 0u; i < length; i++)
+    {
+        crc = table[(crc ^ data[i]) & 0x0Fu] ^ (crc >> 4);
+        crc = table[(crc ^ ((uint32_t)data[i] >> 4)) & 0x0Fu] ^ (crc >> 4);
+    }
+    return crc;
+}
+
+
+//--------------------------------------------------------------------------------------------------
+// cybsp_logstore_row_crc
+//--------------------------------------------------------------------------------------------------
+static uint32_t cybsp_logstore_row_crc(const cybsp_logstore_row_t* row)
+{
+    uint32_t crc = cybsp_logstore_crc(0xFFFFFFFFu, (const uint8_t*)&row->seq,
+                                      sizeof(row->seq) + sizeof(row->used));
+    return ~cybsp_logstore_crc(crc, row->payload, row->used);
+}
+
+
+//--------------------------------------------------------------------------------------------------
+// cybsp_logstore_row
+//--------------------------------------------------------------------------------------------------
+static const cybsp_logstore_row_t* cybsp_logstore_row(uint32_t index)
+{
+    return (const cybsp_logstore_row_t*)&cybsp_logstore_base[index * CYBSP_LOGSTORE_ROW_SIZE];
+}
+
+
+//--------------------------------------------------------------------------------------------------
+// cybsp_logstore_rec_size
+//--------------------------------------------------------------------------------------------------
+static uint32_t cybsp_logstore_rec_size(const cybsp_logstore_rec_t* rec)
+{
+    return CYBSP_LOGSTORE_REC_HDR_SIZE + (((uint32_t)rec->length + 3u) & ~3u);
+}
+
+
+//--------------------------------------------------------------------------------------------------
+// cybsp_logstore_scan
+//
+// Returns the last record for key in a block of records, or NULL
+//--------------------------------------------------------------------------------------------------
+static const cybsp_logstore_rec_t* cybsp_logstore_scan(const uint8_t* records, uint32_t used,
+                                                      uint16_t key)
+{
+    const cybsp_logstore_rec_t* found = NULL;
+    for (uint32_t offset = 0u; (offset + CYBSP_LOGSTORE_REC_HDR_SIZE) <= used;)
+    {
+        const cybsp_logstore_rec_t* rec = (const cybsp_logstore_rec_t*)&records[offset];
+        if (key == rec->key)
+        {
+            found = rec;
+        }
+        offset += cybsp_logstore_rec_size(rec);
+    }
+    return found;
+}
+
+
+//--------------------------------------------------------------------------------------------------
+// cybsp_logstore_find
+//
+// Returns the latest record for key in the buffer or in any valid row other than skip, or NULL
+//--------------------------------------------------------------------------------------------------
+static const cybsp_logstore_rec_t* cybsp_logstore_find(uint16_t key, uint32_t skip)
+{
+    const cybsp_logstore_rec_t* rec =
+        cybsp_logstore_scan((const uint8_t*)cybsp_logstore_buffer, cybsp_logstore_used, key);
+
+    // Rows from the newest to the oldest
+    for (uint32_t i = 1u; (NULL == rec) && (i < CYBSP_LOGSTORE_ROWS); i++)
+    {
+        uint32_t index = (cybsp_logstore_head + CYBSP_LOGSTORE_ROWS - i) % CYBSP_LOGSTORE_ROWS;
+        if ((index != skip) && (0u != cybsp_logstore_seq[index]))
+        {
+            const cybsp_logstore_row_t* row = cybsp_logstore_row(index);
+            rec = cybsp_logstore_scan(row->payload, row->used, key);
+        }
+    }
+    return rec;
+}
+
+
+//--------------------------------------------------------------------------------------------------
+// cybsp_logstore_carry
+//
+// Copies the records of the oldest row that have no newer copy into the row image
+//--------------------------------------------------------------------------------------------------
+static void cybsp_logstore_carry(uint32_t victim)
+{
+    const cybsp_logstore_row_t* row = cybsp_logstore_row(victim);
+    for (uint32_t offset = 0u; (offset + CYBSP_LOGSTORE_REC_HDR_SIZE) <= row->used;)
+    {
+        const cybsp_logstore_rec_t* rec  = (const cybsp_logstore_rec_t*)&row->payload[offset];
+        uint32_t                    size = cybsp_logstore_rec_size(rec);
+        offset += size;
+
+        // Removals have nothing older left to hide once their row is the oldest
+        if ((0u != rec->length) &&
+            (rec == cybsp_logstore_scan(row->payload, row->used, rec->key)) &&
+            (NULL == cybsp_logstore_find(rec->key, victim)))
+        {
+            (void)memcpy(&cybsp_logstore_image.payload[cybsp_logstore_image.used], rec, size);
+            cybsp_logstore_image.used += (uint16_t)size;
+            cybsp_logstore_stats.carried++;
+        }
+    }
+}
+
+
+//--------------------------------------------------------------------------------------------------
+// cybsp_logstore_write
+//
+// Writes buffered records to flash in at most max_rows row passes
+//--------------------------------------------------------------------------------------------------
+static cy_rslt_t cybsp_logstore_write(uint32_t max_rows)
+{
+    cy_rslt_t result = CY_RSLT_SUCCESS;
+    if (0u != cybsp_logstore_used)
+    {
+        cybsp_logstore_stats.flushes++;
+    }
+
+    // Each pass writes the free row and frees the oldest one. When the live records fill every
+    // row nothing of the buffer fits anymore.
+    for (uint32_t pass = 0u; (CY_RSLT_SUCCESS == result) && (0u != cybsp_logstore_used) &&
+         (pass < max_rows); pass++)
+    {
+        if (pass >= CYBSP_LOGSTORE_ROWS)
+        {
+            result = CYBSP_RSLT_ERR_LOGSTORE_FULL;
+            break;
+        }
+
+        uint32_t target = cybsp_logstore_head;
+        uint32_t victim = (target + 1u) % CYBSP_LOGSTORE_ROWS;
+
+        cybsp_logstore_image.used = 0u;
+        if (0u != cybsp_logstore_seq[victim])
+        {
+            cybsp_logstore_carry(victim);
+        }
+
+        const uint8_t* buffer   = (const uint8_t*)cybsp_logstore_buffer;
+        uint32_t       consumed = 0u;
+        while (consumed < cybsp_logstore_used)
+        {
+            uint32_t size = cybsp_logstore_rec_size((const cybsp_logstore_rec_t*)&buffer[consumed]);
+            if ((cybsp_logstore_image.used + size) > CYBSP_LOGSTORE_PAYLOAD)
+            {
+                break;
+            }
+            (void)memcpy(&cybsp_logstore_image.payload[cybsp_logstore_image.used],
+                         &buffer[consumed], size);
+            cybsp_logstore_image.used += (uint16_t)size;
+            consumed                  += size;
+        }
+
+        (void)memset(&cybsp_logstore_image.payload[cybsp_logstore_image.used], 0,
+                     CYBSP_LOGSTORE_PAYLOAD - cybsp_logstore_image.used);
+        cybsp_logstore_image.magic    = CYBSP_LOGSTORE_MAGIC;
+        cybsp_logstore_image.seq      = cybsp_logstore_next_seq;
+        cybsp_logstore_image.reserved = 0u;
+        cybsp_logstore_image.crc      = cybsp_logstore_row_crc(&cybsp_logstore_image);
+
+        if (CY_FLASH_DRV_SUCCESS != Cy_Flash_WriteRow((uint32_t)cybsp_logstore_row(target),
+                                                      (const uint32_t*)&cybsp_logstore_image))
+        {
+            result = CYBSP_RSLT_ERR_LOGSTORE_FLASH;
+            break;
+        }
+
+        cybsp_logstore_seq[target] = cybsp_logstore_next_seq++;
+        cybsp_logstore_seq[victim] = 0u;
+        cybsp_logstore_head        = victim;
+        cybsp_logstore_stats.rows_written++;
+
+        cybsp_logstore_used -= consumed;
+        (void)memmove(cybsp_logstore_buffer, &buffer[consumed], cybsp_logstore_used);
+    }
+
+    // Records left after a partial write are still pending, after a failure they wait for the
+    // next append or an explicit flush
+    cybsp_logstore_pending = (CY_RSLT_SUCCESS == result) && (0u != cybsp_logstore_used);
+    return result;
+}
+
+
+//--------------------------------------------------------------------------------------------------
+// cybsp_logstore_pm_callback
+//--------------------------------------------------------------------------------------------------
+static cy_en_syspm_status_t cybsp_logstore_pm_callback(cy_stc_syspm_callback_params_t* params,
+                                                       cy_en_syspm_callback_mode_t mode)
+{
+    CY_UNUSED_PARAMETER(params);
+    if ((CY_SYSPM_CHECK_READY == mode) && cybsp_logstore_pending)
+    {
+        // Deep sleep is often entered with interrupts masked (tickless idle), so write a single
+        // row at most. Records that are not written stay in RAM, which is retained in deep sleep.
+        (void)cybsp_logstore_write(1u);
+    }
+    return CY_SYSPM_SUCCESS;
+}
+
+
+//--------------------------------------------------------------------------------------------------
+// cybsp_logstore_init
+//--------------------------------------------------------------------------------------------------
+cy_rslt_t cybsp_logstore_init(void)
+{
+    static cy_stc_syspm_callback_params_t cybsp_logstore_pm_callback_param = { NULL, NULL };
+    static cy_stc_syspm_callback_t        cybsp_logstore_pm_callback_obj   =
+    {
+        .callback       = &cybsp_logstore_pm_callback,
+        .type           = CY_SYSPM_DEEPSLEEP,
+        .callbackParams = &cybsp_logstore_pm_callback_param
+    };
+    static bool cybsp_logstore_registered = false;
+
+    uint32_t newest  = CYBSP_LOGSTORE_ROWS - 1u;
+    uint32_t max_seq = 0u;
+    for (uint32_t i = 0u; i < CYBSP_LOGSTORE_ROWS; i++)
+    {
+        const cybsp_logstore_row_t* row = cybsp_logstore_row(i);
+        bool valid = (CYBSP_LOGSTORE_MAGIC == row->magic) &&
+                     (row->used <= CYBSP_LOGSTORE_PAYLOAD) &&
+                     (row->crc == cybsp_logstore_row_crc(row));
+        cybsp_logstore_seq[i] = valid ? row->seq : 0u;
+        if (valid && (row->seq > max_seq))
+        {
+            max_seq = row->seq;
+            newest  = i;
+        }
+    }
+
+    // The row after the newest was the oldest when the newest was written, and everything live
+    // in it was carried over, so it is the free row.
+    cybsp_logstore_head                     = (newest + 1u) % CYBSP_LOGSTORE_ROWS;
+    cybsp_logstore_seq[cybsp_logstore_head] = 0u;
+    cybsp_logstore_next_seq                 = max_seq + 1u;
+    cybsp_logstore_used                     = 0u;
+    cybsp_logstore_pending                  = false;
+
+    cy_rslt_t result = CY_RSLT_SUCCESS;
+    if (!cybsp_logstore_registered)
+    {
+        cybsp_logstore_registered = Cy_SysPm_RegisterCallback(&cybsp_logstore_pm_callback_obj);
+        if (!cybsp_logstore_registered)
+        {
+            result = CYBSP_RSLT_ERR_LOGSTORE_FLASH;
+        }
+    }
+    return result;
+}
+
+
+//--------------------------------------------------------------------------------------------------
+// cybsp_logstore_format
+//--------------------------------------------------------------------------------------------------
+cy_rslt_t cybsp_logstore_format(void)
+{
+    cy_rslt_t result = CY_RSLT_SUCCESS;
+    for (uint32_t i = 0u; (CY_RSLT_SUCCESS == result) && (i < CYBSP_LOGSTORE_ROWS); i++)
+    {
+        if (CY_FLASH_DRV_SUCCESS != Cy_Flash_EraseRow((uint32_t)cybsp_logstore_row(i)))
+        {
+            result = CYBSP_RSLT_ERR_LOGSTORE_FLASH;
+        }
+        cybsp_logstore_seq[i] = 0u;
+    }
+    cybsp_logstore_head     = 0u;
+    cybsp_logstore_next_seq = 1u;
+    cybsp_logstore_used     = 0u;
+    cybsp_logstore_pending  = false;
+    return result;
+}
+
+
+//--------------------------------------------------------------------------------------------------
+// cybsp_logstore_append
+//--------------------------------------------------------------------------------------------------
+cy_rslt_t cybsp_logstore_append(uint16_t key, const void* data, uint16_t length)
+{
+    if ((0u == length) || (NULL == data) || (length > CYBSP_LOGSTORE_MAX_VALUE))
+    {
+        return CYBSP_RSLT_ERR_LOGSTORE_BAD_ARG;
+    }
+
+    cybsp_logstore_rec_t rec    = { .key = key, .length = length };
+    uint32_t             size   = cybsp_logstore_rec_size(&rec);
+    cy_rslt_t            result = CY_RSLT_SUCCESS;
+    if ((cybsp_logstore_used + size) > CYBSP_LOGSTORE_PAYLOAD)
+    {
+        result = cybsp_logstore_flush();
+    }
+
+    if (CY_RSLT_SUCCESS == result)
+    {
+        uint8_t* dst = &((uint8_t*)cybsp_logstore_buffer)[cybsp_logstore_used];
+        (void)memcpy(dst, &rec, CYBSP_LOGSTORE_REC_HDR_SIZE);
+        (void)memcpy(&dst[CYBSP_LOGSTORE_REC_HDR_SIZE], data, length);
+        (void)memset(&dst[CYBSP_LOGSTORE_REC_HDR_SIZE + length], 0,
+                     size - CYBSP_LOGSTORE_REC_HDR_SIZE - length);
+        cybsp_logstore_used   += size;
+        cybsp_logstore_pending = true;
+        cybsp_logstore_stats.appended++;
+    }
+    return result;
+}
+
+
+//--------------------------------------------------------------------------------------------------
+// cybsp_logstore_read
+//--------------------------------------------------------------------------------------------------
+cy_rslt_t cybsp_logstore_read(uint16_t key, void* data, uint16_t size, uint16_t* length)
+{
+    const cybsp_logstore_rec_t* rec = cybsp_logstore_find(key, CYBSP_LOGSTORE_ROWS);
+    if ((NULL == rec) || (0u == rec->length))
+    {
+        return CYBSP_RSLT_ERR_LOGSTORE_NOT_FOUND;
+    }
+
+    if (NULL != data)
+    {
+        (void)memcpy(data, &((const uint8_t*)rec)[CYBSP_LOGSTORE_REC_HDR_SIZE],
+                     (size < rec->length) ? size : rec->length);
+    }
+    if (NULL != length)
+    {
+        *length = rec->length;
+    }
+    return CY_RSLT_SUCCESS;
+}
+
+
+//--------------------------------------------------------------------------------------------------
+// cybsp_logstore_remove
+//--------------------------------------------------------------------------------------------------
+cy_rslt_t cybsp_logstore_remove(uint16_t key)
+{
+    cybsp_logstore_rec_t rec    = { .key = key, .length = 0u };
+    cy_rslt_t            result = CY_RSLT_SUCCESS;
+    if ((cybsp_logstore_used + CYBSP_LOGSTORE_REC_HDR_SIZE) > CYBSP_LOGSTORE_PAYLOAD)
+    {
+        result = cybsp_logstore_flush();
+    }
+    if (CY_RSLT_SUCCESS == result)
+    {
+        (void)memcpy(&((uint8_t*)cybsp_logstore_buffer)[cybsp_logstore_used], &rec,
+                     CYBSP_LOGSTORE_REC_HDR_SIZE);
+        cybsp_logstore_used   += CYBSP_LOGSTORE_REC_HDR_SIZE;
+        cybsp_logstore_pending = true;
+    }
+    return result;
+}
+
+
+//--------------------------------------------------------------------------------------------------
+// cybsp_logstore_flush
+//--------------------------------------------------------------------------------------------------
+cy_rslt_t cybsp_logstore_flush(void)
+{
+    // One pass more than there are rows reports a store that is full
+    return cybsp_logstore_write(CYBSP_LOGSTORE_ROWS + 1u);
+}
+
+
+//--------------------------------------------------------------------------------------------------
+// cybsp_logstore_get_stats
+//--------------------------------------------------------------------------------------------------
+void cybsp_logstore_get_stats(cybsp_logstore_stats_t* stats)
+{
+    CY_ASSERT(NULL != stats);
+    *stats = cybsp_logstore_stats;
+}
+
+
+#if defined(__cplusplus)
+}
+#endif
+
+#endif // defined(CYBSP_LOGSTORE)
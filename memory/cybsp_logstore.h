@@ -0,0 +1,139 @@
+/***********************************************************************************************//**
+ * \file cybsp_logstore.h
+ *
+ * \brief
+ * Wear-leveled, log-structured key/value store in the emulated EEPROM flash region.
+ *
+ ***************************************************************************************************
+ * \copyright
+ * Copyright 2023 Cypress Semiconductor Corporation (an Infineon company) or
+ * an affiliate of Cypress Semiconductor Corporation
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ **************************************************************************************************/
+
+#pragma once
+
+#include <stdint.h>
+#include "cy_result.h"
+
+#if defined(__cplusplus)
+extern "C" {
+#endif
+
+/**
+ * \addtogroup group_bsp_logstore Log Store
+ * \{
+ * Records are appended to a RAM write-back buffer of one flash row and only written when the
+ * buffer is full, on \ref cybsp_logstore_flush, or on deep sleep entry through a Cy_SysPm
+ * callback. The callback writes at most one row, and only if records were buffered since the last
+ * write attempt, since deep sleep may be entered with interrupts masked. Rows of the .cy_em_eeprom
+ * section are written in a circle, so every row is erased once per pass over the store regardless
+ * of which keys are updated.
+ *
+ * Each row carries a sequence number and a CRC over its records. Mounting only validates the
+ * row headers; a row torn by a reset during programming fails its CRC and is ignored. One row is
+ * always kept free: before a row is reused, the records in the oldest row that have no newer
+ * copy are carried over into the row being written, so no data is lost if a write is
+ * interrupted. The latest record of a key is its value; \ref cybsp_logstore_remove appends an
+ * empty record that hides older ones.
+ *
+ * The store is not reentrant and must not be used from interrupt context. It has no lock of its
+ * own: when several tasks use it, the application must serialize the calls, for example with a
+ * mutex, and must not enter deep sleep from a task while another one is inside a call. Writes use
+ * the blocking Cy_Flash API.
+ */
+
+#if defined(CYBSP_LOGSTORE)
+
+#if !defined(CYBSP_LOGSTORE_SIZE)
+/** Size of the store in bytes, a multiple of the 512 byte flash row, at most 32 KB. The rest of
+ * the em_eeprom region remains available to the Emulated EEPROM middleware. */
+#define CYBSP_LOGSTORE_SIZE             (0x4000u)
+#endif
+
+/** Maximum length of a record value in bytes */
+#define CYBSP_LOGSTORE_MAX_VALUE        (492u)
+
+/** Store statistics, see \ref cybsp_logstore_get_stats */
+typedef struct
+{
+    uint32_t appended;      /**< Records appended */
+    uint32_t rows_written;  /**< Flash rows written */
+    uint32_t carried;       /**< Records carried over from reused rows */
+    uint32_t flushes;       /**< Calls to \ref cybsp_logstore_flush that wrote to flash */
+} cybsp_logstore_stats_t;
+
+/**
+ * \brief Mounts the store and registers its deep sleep callback.
+ * \returns CY_RSLT_SUCCESS if the store was mounted, CYBSP_RSLT_ERR_LOGSTORE_FLASH if the
+ *          callback could not be registered
+ */
+cy_rslt_t cybsp_logstore_init(void);
+
+/**
+ * \brief Erases all rows of the store and discards buffered records.
+ * \returns CY_RSLT_SUCCESS if the store was erased, CYBSP_RSLT_ERR_LOGSTORE_FLASH otherwise
+ */
+cy_rslt_t cybsp_logstore_format(void);
+
+/**
+ * \brief Appends a record. The buffer is flushed first if the record does not fit in it.
+ * \param key    Record key
+ * \param data   Record value
+ * \param length Length of the value, 1 to \ref CYBSP_LOGSTORE_MAX_VALUE
+ * \returns CY_RSLT_SUCCESS if the record was buffered, CYBSP_RSLT_ERR_LOGSTORE_BAD_ARG if the
+ *          length is invalid, or the error from the flush
+ */
+cy_rslt_t cybsp_logstore_append(uint16_t key, const void* data, uint16_t length);
+
+/**
+ * \brief Reads the latest value of a key.
+ * \param key    Record key
+ * \param data   Filled with the value, truncated to size
+ * \param size   Size of data in bytes
+ * \param length Set to the full length of the value, may be NULL
+ * \returns CY_RSLT_SUCCESS if the key was found, CYBSP_RSLT_ERR_LOGSTORE_NOT_FOUND otherwise
+ */
+cy_rslt_t cybsp_logstore_read(uint16_t key, void* data, uint16_t size, uint16_t* length);
+
+/**
+ * \brief Removes a key by appending an empty record.
+ * \param key Record key
+ * \returns CY_RSLT_SUCCESS if the removal was buffered, or the error from the flush
+ */
+cy_rslt_t cybsp_logstore_remove(uint16_t key);
+
+/**
+ * \brief Writes all buffered records to flash.
+ * \returns CY_RSLT_SUCCESS if the buffer is empty, CYBSP_RSLT_ERR_LOGSTORE_FULL if the live
+ *          records do not leave room for the buffered ones, CYBSP_RSLT_ERR_LOGSTORE_FLASH if a row
+ *          write failed
+ */
+cy_rslt_t cybsp_logstore_flush(void);
+
+/**
+ * \brief Returns the store statistics.
+ * \param stats Filled with the statistics
+ */
+void cybsp_logstore_get_stats(cybsp_logstore_stats_t* stats);
+
+#endif // defined(CYBSP_LOGSTORE)
+
+/** \} group_bsp_logstore */
+
+#ifdef __cplusplus
+}
+#endif // __cplusplus
@@ -0,0 +1,119 @@
+/***********************************************************************************************//**
+ * \file cybsp_mem_usage.c
+ *
+ * Description:
+ * Finds the stack high-watermark and the heap peak usage from the pattern painted at reset.
+ *
+ ***************************************************************************************************
+ * \copyright
+ * Copyright 2023 Cypress Semiconductor Corporation (an Infineon company) or
+ * an affiliate of Cypress Semiconductor Corporation
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ **************************************************************************************************/
+
+#if defined(CYBSP_MEM_USAGE)
+
+#include <stddef.h>
+#include "cy_syslib.h"
+#include "cybsp.h"
+
+#if defined(__cplusplus)
+extern "C" {
+#endif
+
+#if defined(__ARMCC_VERSION)
+extern uint32_t Image$$ARM_LIB_HEAP$$ZI$$Base[];
+extern uint32_t Image$$ARM_LIB_HEAP$$ZI$$Limit[];
+extern uint32_t Image$$ARM_LIB_STACK$$ZI$$Base[];
+extern uint32_t Image$$ARM_LIB_STACK$$ZI$$Limit[];
+    #define CYBSP_MEM_USAGE_HEAP_BASE   (Image$$ARM_LIB_HEAP$$ZI$$Base)
+    #define CYBSP_MEM_USAGE_HEAP_LIMIT  (Image$$ARM_LIB_HEAP$$ZI$$Limit)
+    #define CYBSP_MEM_USAGE_STACK_BASE  (Image$$ARM_LIB_STACK$$ZI$$Base)
+    #define CYBSP_MEM_USAGE_STACK_LIMIT (Image$$ARM_LIB_STACK$$ZI$$Limit)
+#elif defined(__ICCARM__)
+#pragma section="HEAP"
+#pragma section="CSTACK"
+    #define CYBSP_MEM_USAGE_HEAP_BASE   ((uint32_t*)__section_begin("HEAP"))
+    #define CYBSP_MEM_USAGE_HEAP_LIMIT  ((uint32_t*)__section_end("HEAP"))
+    #define CYBSP_MEM_USAGE_STACK_BASE  ((uint32_t*)__section_begin("CSTACK"))
+    #define CYBSP_MEM_USAGE_STACK_LIMIT ((uint32_t*)__section_end("CSTACK"))
+#elif defined(__APPLE__) && defined(__clang__)
+    #error "CYBSP_MEM_USAGE is not supported with the A_Clang toolchain"
+#elif defined(__GNUC__)
+extern uint32_t __HeapBase[];
+extern uint32_t __HeapLimit[];
+extern uint32_t __StackLimit[];
+extern uint32_t __StackTop[];
+    #define CYBSP_MEM_USAGE_HEAP_BASE   (__HeapBase)
+    #define CYBSP_MEM_USAGE_HEAP_LIMIT  (__HeapLimit)
+    #define CYBSP_MEM_USAGE_STACK_BASE  (__StackLimit)
+    #define CYBSP_MEM_USAGE_STACK_LIMIT (__StackTop)
+#else
+    #error "Unsupported toolchain"
+#endif
+
+//--------------------------------------------------------------------------------------------------
+// cybsp_mem_usage_get
+//--------------------------------------------------------------------------------------------------
+void cybsp_mem_usage_get(cybsp_mem_usage_t* usage)
+{
+    CY_ASSERT(NULL != usage);
+
+    const volatile uint32_t* stack_base  = CYBSP_MEM_USAGE_STACK_BASE;
+    const volatile uint32_t* stack_limit = CYBSP_MEM_USAGE_STACK_LIMIT;
+    const volatile uint32_t* heap_base   = CYBSP_MEM_USAGE_HEAP_BASE;
+    const volatile uint32_t* heap_limit  = CYBSP_MEM_USAGE_HEAP_LIMIT;
+
+    // The stack grows down: the first word from the bottom that was overwritten is the deepest
+    const volatile uint32_t* stack_mark = stack_base;
+    while ((stack_mark < stack_limit) && (CYBSP_MEM_USAGE_PAINT == *stack_mark))
+    {
+        stack_mark++;
+    }
+
+    // The last word from the end of the heap that was overwritten is the highest in use
+    const volatile uint32_t* heap_mark = heap_limit;
+    while ((heap_mark > heap_base) && (CYBSP_MEM_USAGE_PAINT == heap_mark[-1]))
+    {
+        heap_mark--;
+    }
+
+    usage->stack_size = (uint32_t)((uintptr_t)stack_limit - (uintptr_t)stack_base);
+    usage->stack_peak = (uint32_t)((uintptr_t)stack_limit - (uintptr_t)stack_mark);
+    usage->heap_size  = (uint32_t)((uintptr_t)heap_limit - (uintptr_t)heap_base);
+    usage->heap_peak  = (uint32_t)((uintptr_t)heap_mark - (uintptr_t)heap_base);
+}
+
+
+//--------------------------------------------------------------------------------------------------
+// cybsp_mem_usage_dump
+//--------------------------------------------------------------------------------------------------
+void cybsp_mem_usage_dump(const cybsp_mem_usage_t* usage, cybsp_mem_usage_print_t print_fn)
+{
+    if ((NULL != usage) && (NULL != print_fn))
+    {
+        (void)print_fn("stack %6lu of %6lu bytes\r\nheap  %6lu of %6lu bytes\r\n",
+                       (unsigned long)usage->stack_peak, (unsigned long)usage->stack_size,
+                       (unsigned long)usage->heap_peak, (unsigned long)usage->heap_size);
+    }
+}
+
+
+#if defined(__cplusplus)
+}
+#endif
+
+#endif // defined(CYBSP_MEM_USAGE)
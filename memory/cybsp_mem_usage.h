@@ -0,0 +1,94 @@
+/***********************************************************************************************//**
+ * \file cybsp_mem_usage.h
+ *
+ * \brief
+ * Stack high-watermark and heap peak usage of the CM4 image.
+ *
+ ***************************************************************************************************
+ * \copyright
+ * Copyright 2023 Cypress Semiconductor Corporation (an Infineon company) or
+ * an affiliate of Cypress Semiconductor Corporation
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ **************************************************************************************************/
+
+#pragma once
+
+#include <stdint.h>
+
+#if defined(__cplusplus)
+extern "C" {
+#endif
+
+/**
+ * \addtogroup group_bsp_mem_usage Memory Usage
+ * \{
+ * The main stack size and the minimum heap size are set with the CYBSP_STACK_SIZE and
+ * CYBSP_HEAP_SIZE make variables (see bsp.mk), which every toolchain's startup code and linker
+ * script honor. The heap takes the SRAM left between the data sections and the stack.
+ *
+ * When CYBSP_MEM_USAGE is defined, Reset_Handler fills the heap and the main stack with
+ * \ref CYBSP_MEM_USAGE_PAINT before anything else runs, and \ref cybsp_mem_usage_get finds how
+ * far each was used from the words that still hold the pattern. The stack watermark is the
+ * deepest word written below the stack top; the heap peak is the highest word written above the
+ * heap base, which all supported allocators grow from. Both are upper bounds of the real usage
+ * only if the pattern is not a value the application stores, and memory that was allocated but
+ * never written is not counted.
+ *
+ * With an RTOS the main stack is only used until the scheduler starts and by interrupts
+ * afterwards; task stacks allocated from the heap count as heap usage.
+ *
+ * \note Painting the heap adds a few tens of milliseconds to the boot time, since it runs before
+ * the clocks are configured. Not available with the A_Clang toolchain.
+ */
+
+#if defined(CYBSP_MEM_USAGE)
+
+/** Fill pattern written by Reset_Handler, must match the startup code. */
+#define CYBSP_MEM_USAGE_PAINT       (0xA5A5A5A5u)
+
+/** Memory usage, see \ref cybsp_mem_usage_get */
+typedef struct
+{
+    uint32_t stack_size;    /**< Size of the main stack in bytes */
+    uint32_t stack_peak;    /**< Deepest main stack usage since reset in bytes */
+    uint32_t heap_size;     /**< Size of the heap region in bytes */
+    uint32_t heap_peak;     /**< Highest heap offset written since reset in bytes */
+} cybsp_mem_usage_t;
+
+/** printf compatible function used to print the usage */
+typedef int (*cybsp_mem_usage_print_t)(const char* format, ...);
+
+/**
+ * \brief Returns the stack high-watermark and the heap peak usage since reset.
+ * The heap is scanned from its end, which takes a few milliseconds when most of it is unused.
+ * \param usage Filled with the memory usage
+ */
+void cybsp_mem_usage_get(cybsp_mem_usage_t* usage);
+
+/**
+ * \brief Prints the memory usage.
+ * \param usage    Memory usage returned by \ref cybsp_mem_usage_get
+ * \param print_fn printf compatible function used for the output
+ */
+void cybsp_mem_usage_dump(const cybsp_mem_usage_t* usage, cybsp_mem_usage_print_t print_fn);
+
+#endif // defined(CYBSP_MEM_USAGE)
+
+/** \} group_bsp_mem_usage */
+
+#ifdef __cplusplus
+}
+#endif // __cplusplus
@@ -0,0 +1,300 @@
+/***********************************************************************************************//**
+ * \file cybsp_pool.c
+ *
+ * Description:
+ * Fixed-size block pools with lock-free free lists.
+ *
+ ***************************************************************************************************
+ * \copyright
+ * Copyright 2023 Cypress Semiconductor Corporation (an Infineon company) or
+ * an affiliate of Cypress Semiconductor Corporation
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ **************************************************************************************************/
+
+#if defined(CYBSP_POOL)
+
+#include <stddef.h>
+#include "cy_device_headers.h"
+#include "cy_syslib.h"
+#include "cybsp.h"
+
+#if defined(__cplusplus)
+extern "C" {
+#endif
+
+#if ((CYBSP_POOL_SMALL_SIZE % 8u) != 0u) || ((CYBSP_POOL_MEDIUM_SIZE % 8u) != 0u) || \
+    ((CYBSP_POOL_LARGE_SIZE % 8u) != 0u)
+    #error "CYBSP_POOL block sizes must be multiples of 8 bytes"
+#endif
+#if (CYBSP_POOL_SMALL_SIZE >= CYBSP_POOL_MEDIUM_SIZE) || \
+    (CYBSP_POOL_MEDIUM_SIZE >= CYBSP_POOL_LARGE_SIZE)
+    #error "CYBSP_POOL block sizes must increase from the small to the large class"
+#endif
+
+// A free block holds the link to the next free block
+typedef struct cybsp_pool_block
+{
+    struct cybsp_pool_block* next;
+} cybsp_pool_block_t;
+
+typedef struct
+{
+    uint8_t*                        start;
+    uint32_t                        block_size;
+    uint32_t                        block_count;
+    cybsp_pool_block_t* volatile    free;
+    volatile uint32_t               in_use;
+    volatile uint32_t               high_water;
+    volatile uint32_t               allocs;
+    volatile uint32_t               fallbacks;
+    volatile uint32_t               failures;
+} cybsp_pool_t;
+
+CYBSP_SECTION_POOL static uint8_t
+    cybsp_pool_small[CYBSP_POOL_SMALL_COUNT * CYBSP_POOL_SMALL_SIZE];
+CYBSP_SECTION_POOL static uint8_t
+    cybsp_pool_medium[CYBSP_POOL_MEDIUM_COUNT * CYBSP_POOL_MEDIUM_SIZE];
+CYBSP_SECTION_POOL static uint8_t
+    cybsp_pool_large[CYBSP_POOL_LARGE_COUNT * CYBSP_POOL_LARGE_SIZE];
+
+static cybsp_pool_t cybsp_pools[CYBSP_POOL_CLASS_COUNT] =
+{
+    { .start = cybsp_pool_small,  .block_size  = CYBSP_POOL_SMALL_SIZE,
+      .block_count = CYBSP_POOL_SMALL_COUNT },
+    { .start = cybsp_pool_medium, .block_size  = CYBSP_POOL_MEDIUM_SIZE,
+      .block_count = CYBSP_POOL_MEDIUM_COUNT },
+    { .start = cybsp_pool_large,  .block_size  = CYBSP_POOL_LARGE_SIZE,
+      .block_count = CYBSP_POOL_LARGE_COUNT }
+};
+
+static const char* const cybsp_pool_names[CYBSP_POOL_CLASS_COUNT] =
+{
+    "small", "medium", "large"
+};
+
+//--------------------------------------------------------------------------------------------------
+// cybsp_pool_atomic_add
+//--------------------------------------------------------------------------------------------------
+static uint32_t cybsp_pool_atomic_add(volatile uint32_t* value, uint32_t delta)
+{
+    uint32_t result;
+    do
+    {
+        result = __LDREXW(value) + delta;
+    } while (0u != __STREXW(result, value));
+    return result;
+}
+
+
+//--------------------------------------------------------------------------------------------------
+// cybsp_pool_atomic_max
+//--------------------------------------------------------------------------------------------------
+static void cybsp_pool_atomic_max(volatile uint32_t* value, uint32_t candidate)
+{
+    for (;;)
+    {
+        if (__LDREXW(value) >= candidate)
+        {
+            __CLREX();
+            break;
+        }
+        if (0u == __STREXW(candidate, value))
+        {
+            break;
+        }
+    }
+}
+
+
+//--------------------------------------------------------------------------------------------------
+// cybsp_pool_pop
+//--------------------------------------------------------------------------------------------------
+static cybsp_pool_block_t* cybsp_pool_pop(cybsp_pool_t* pool)
+{
+    cybsp_pool_block_t* block;
+    for (;;)
+    {
+        block = (cybsp_pool_block_t*)__LDREXW((volatile uint32_t*)&pool->free);
+        if (NULL == block)
+        {
+            __CLREX();
+            break;
+        }
+        // Any other pop or push in between comes from an interrupt or a task switch, which clears
+        // the exclusive monitor, so block->next cannot be stale when the store succeeds.
+        if (0u == __STREXW((uint32_t)block->next, (volatile uint32_t*)&pool->free))
+        {
+            break;
+        }
+    }
+    return block;
+}
+
+
+//--------------------------------------------------------------------------------------------------
+// cybsp_pool_push
+//--------------------------------------------------------------------------------------------------
+static void cybsp_pool_push(cybsp_pool_t* pool, cybsp_pool_block_t* block)
+{
+    do
+    {
+        block->next = (cybsp_pool_block_t*)__LDREXW((volatile uint32_t*)&pool->free);
+    } while (0u != __STREXW((uint32_t)block, (volatile uint32_t*)&pool->free));
+}
+
+
+//--------------------------------------------------------------------------------------------------
+// cybsp_pool_init
+//--------------------------------------------------------------------------------------------------
+void cybsp_pool_init(void)
+{
+    for (uint32_t c = 0u; c < CYBSP_POOL_CLASS_COUNT; c++)
+    {
+        cybsp_pool_t*       pool = &cybsp_pools[c];
+        cybsp_pool_block_t* next = NULL;
+
+        // Link the blocks from the end so they are handed out in address order
+        for (uint32_t i = pool->block_count; i > 0u; i--)
+        {
+            cybsp_pool_block_t* block =
+                (cybsp_pool_block_t*)&pool->start[(i - 1u) * pool->block_size];
+            block->next = next;
+            next        = block;
+        }
+
+        uint32_t savedIntrStatus = Cy_SysLib_EnterCriticalSection();
+        pool->free       = next;
+        pool->in_use     = 0u;
+        pool->high_water = 0u;
+        pool->allocs     = 0u;
+        pool->fallbacks  = 0u;
+        pool->failures   = 0u;
+        Cy_SysLib_ExitCriticalSection(savedIntrStatus);
+    }
+}
+
+
+//--------------------------------------------------------------------------------------------------
+// cybsp_pool_alloc
+//--------------------------------------------------------------------------------------------------
+void* cybsp_pool_alloc(size_t size)
+{
+    uint32_t wanted = 0u;
+    while ((wanted < CYBSP_POOL_CLASS_COUNT) && (size > cybsp_pools[wanted].block_size))
+    {
+        wanted++;
+    }
+    if (wanted >= CYBSP_POOL_CLASS_COUNT)
+    {
+        return NULL;
+    }
+
+    cybsp_pool_block_t* block = NULL;
+    for (uint32_t c = wanted; (NULL == block) && (c < CYBSP_POOL_CLASS_COUNT); c++)
+    {
+        cybsp_pool_t* pool = &cybsp_pools[c];
+        block = cybsp_pool_pop(pool);
+        if (NULL != block)
+        {
+            cybsp_pool_atomic_max(&pool->high_water, cybsp_pool_atomic_add(&pool->in_use, 1u));
+            (void)cybsp_pool_atomic_add(&pool->allocs, 1u);
+            if (c != wanted)
+            {
+                (void)cybsp_pool_atomic_add(&cybsp_pools[wanted].fallbacks, 1u);
+            }
+        }
+    }
+
+    if (NULL == block)
+    {
+        (void)cybsp_pool_atomic_add(&cybsp_pools[wanted].failures, 1u);
+    }
+    return block;
+}
+
+
+//--------------------------------------------------------------------------------------------------
+// cybsp_pool_free
+//--------------------------------------------------------------------------------------------------
+void cybsp_pool_free(void* block)
+{
+    if (NULL != block)
+    {
+        uint32_t c = 0u;
+        for (; c < CYBSP_POOL_CLASS_COUNT; c++)
+        {
+            cybsp_pool_t* pool   = &cybsp_pools[c];
+            uint32_t      offset = (uint32_t)((uint8_t*)block - pool->start);
+            if (((uint8_t*)block >= pool->start) &&
+                (offset < (pool->block_count * pool->block_size)))
+            {
+                CY_ASSERT(0u == (offset % pool->block_size));
+                cybsp_pool_push(pool, (cybsp_pool_block_t*)block);
+                (void)cybsp_pool_atomic_add(&pool->in_use, UINT32_MAX);
+                break;
+            }
+        }
+        // The block was not allocated from the pools
+        CY_ASSERT(c < CYBSP_POOL_CLASS_COUNT);
+    }
+}
+
+
+//--------------------------------------------------------------------------------------------------
+// cybsp_pool_get_stats
+//--------------------------------------------------------------------------------------------------
+void cybsp_pool_get_stats(cybsp_pool_class_t pool_class, cybsp_pool_stats_t* stats)
+{
+    CY_ASSERT((pool_class < CYBSP_POOL_CLASS_COUNT) && (NULL != stats));
+
+    const cybsp_pool_t* pool = &cybsp_pools[pool_class];
+    stats->block_size  = pool->block_size;
+    stats->block_count = pool->block_count;
+    stats->in_use      = pool->in_use;
+    stats->high_water  = pool->high_water;
+    stats->allocs      = pool->allocs;
+    stats->fallbacks   = pool->fallbacks;
+    stats->failures    = pool->failures;
+}
+
+
+//--------------------------------------------------------------------------------------------------
+// cybsp_pool_dump
+//--------------------------------------------------------------------------------------------------
+void cybsp_pool_dump(cybsp_pool_print_t print_fn)
+{
+    if (NULL != print_fn)
+    {
+        for (uint32_t c = 0u; c < CYBSP_POOL_CLASS_COUNT; c++)
+        {
+            cybsp_pool_stats_t stats;
+            cybsp_pool_get_stats((cybsp_pool_class_t)c, &stats);
+            (void)print_fn("%-6s %4lu x %4lu bytes  in use %4lu  peak %4lu  allocs %8lu  "
+                           "fallbacks %6lu  failures %6lu\r\n", cybsp_pool_names[c],
+                           (unsigned long)stats.block_count, (unsigned long)stats.block_size,
+                           (unsigned long)stats.in_use, (unsigned long)stats.high_water,
+                           (unsigned long)stats.allocs, (unsigned long)stats.fallbacks,
+                           (unsigned long)stats.failures);
+        }
+    }
+}
+
+
+#if defined(__cplusplus)
+}
+#endif
+
+#endif // defined(CYBSP_POOL)
@@ -0,0 +1,154 @@
+/***********************************************************************************************//**
+ * \file cybsp_pool.h
+ *
+ * \brief
+ * Lock-free fixed-size block pools for HCI packets and Wi-Fi frames.
+ *
+ ***************************************************************************************************
+ * \copyright
+ * Copyright 2023 Cypress Semiconductor Corporation (an Infineon company) or
+ * an affiliate of Cypress Semiconductor Corporation
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ **************************************************************************************************/
+
+#pragma once
+
+#include <stddef.h>
+#include <stdint.h>
+#include "cy_syslib.h"
+
+#if defined(__cplusplus)
+extern "C" {
+#endif
+
+/**
+ * \addtogroup group_bsp_pool Block Pools
+ * \{
+ * When CYBSP_POOL is defined, the BSP provides one pool of fixed-size blocks per size class, sized
+ * for HCI commands and events, HCI ACL packets and Wi-Fi frames. Allocation takes a block from the
+ * free list of the smallest class that fits, or of the next larger class when that one is empty,
+ * so both allocation and release take constant time and the pools never fragment.
+ *
+ * The free lists are lock-free: they are updated with exclusive load/store (LDREX/STREX), which
+ * fails and retries whenever an interrupt or a task switch came in between, so the functions may
+ * be called from any task or interrupt without a critical section.
+ *
+ * The blocks live in their own .cy_pool section in CM4 SRAM, which the startup code does not
+ * initialize; \ref cybsp_init builds the free lists. The block size and count of each class can
+ * be overridden with its CYBSP_POOL_*_SIZE and CYBSP_POOL_*_COUNT define.
+ *
+ * \note The pools are local to the CM4. Buffers exchanged with the other core belong in the
+ * shared SRAM region, see \ref group_bsp_sharedmem.
+ */
+
+#if defined(CYBSP_POOL)
+
+#if !defined(CYBSP_POOL_SMALL_SIZE)
+/** Block size of the small class: HCI commands and events */
+#define CYBSP_POOL_SMALL_SIZE       (64u)
+#endif
+#if !defined(CYBSP_POOL_SMALL_COUNT)
+/** Number of blocks of the small class */
+#define CYBSP_POOL_SMALL_COUNT      (32u)
+#endif
+#if !defined(CYBSP_POOL_MEDIUM_SIZE)
+/** Block size of the medium class: HCI ACL packets with a 251 byte LE payload and headers */
+#define CYBSP_POOL_MEDIUM_SIZE      (272u)
+#endif
+#if !defined(CYBSP_POOL_MEDIUM_COUNT)
+/** Number of blocks of the medium class */
+#define CYBSP_POOL_MEDIUM_COUNT     (16u)
+#endif
+#if !defined(CYBSP_POOL_LARGE_SIZE)
+/** Block size of the large class: 1500 byte Ethernet MTU frames with link and bus headers */
+#define CYBSP_POOL_LARGE_SIZE       (1600u)
+#endif
+#if !defined(CYBSP_POOL_LARGE_COUNT)
+/** Number of blocks of the large class */
+#define CYBSP_POOL_LARGE_COUNT      (8u)
+#endif
+
+/** Places a variable in the pool section */
+#if defined(__APPLE__) && defined(__clang__)
+#define CYBSP_SECTION_POOL          __attribute__((section("__DATA,__cy_pool"))) CY_ALIGN(32)
+#else
+#define CYBSP_SECTION_POOL          CY_SECTION(".cy_pool") CY_ALIGN(32)
+#endif
+
+/** Size classes */
+typedef enum
+{
+    CYBSP_POOL_CLASS_SMALL,         /**< \ref CYBSP_POOL_SMALL_SIZE byte blocks */
+    CYBSP_POOL_CLASS_MEDIUM,        /**< \ref CYBSP_POOL_MEDIUM_SIZE byte blocks */
+    CYBSP_POOL_CLASS_LARGE,         /**< \ref CYBSP_POOL_LARGE_SIZE byte blocks */
+    CYBSP_POOL_CLASS_COUNT          /**< Number of classes, not a valid class */
+} cybsp_pool_class_t;
+
+/** Statistics of a size class, see \ref cybsp_pool_get_stats */
+typedef struct
+{
+    uint32_t block_size;            /**< Size of a block in bytes */
+    uint32_t block_count;           /**< Number of blocks */
+    uint32_t in_use;                /**< Blocks currently allocated */
+    uint32_t high_water;            /**< Most blocks allocated at the same time */
+    uint32_t allocs;                /**< Blocks handed out from this class */
+    uint32_t fallbacks;             /**< Requests served by a larger class because this was empty */
+    uint32_t failures;              /**< Requests for this class that no class could serve */
+} cybsp_pool_stats_t;
+
+/** printf compatible function used to print the statistics */
+typedef int (*cybsp_pool_print_t)(const char* format, ...);
+
+/**
+ * \brief Builds the free lists of all classes. Called by \ref cybsp_init; calling it again
+ * releases all blocks.
+ */
+void cybsp_pool_init(void);
+
+/**
+ * \brief Allocates a block.
+ * \param size Requested size in bytes
+ * \returns A block of at least size bytes aligned to 8 bytes, or NULL if no block is free or the
+ *          size exceeds \ref CYBSP_POOL_LARGE_SIZE
+ */
+void* cybsp_pool_alloc(size_t size);
+
+/**
+ * \brief Returns a block to its pool.
+ * \param block Block returned by \ref cybsp_pool_alloc, or NULL
+ */
+void cybsp_pool_free(void* block);
+
+/**
+ * \brief Returns the statistics of a size class.
+ * \param pool_class Size class
+ * \param stats      Filled with the statistics
+ */
+void cybsp_pool_get_stats(cybsp_pool_class_t pool_class, cybsp_pool_stats_t* stats);
+
+/**
+ * \brief Prints the statistics of all classes.
+ * \param print_fn printf compatible function used for the output
+ */
+void cybsp_pool_dump(cybsp_pool_print_t print_fn);
+
+#endif // defined(CYBSP_POOL)
+
+/** \} group_bsp_pool */
+
+#ifdef __cplusplus
+}
+#endif // __cplusplus
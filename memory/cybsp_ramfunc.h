@@ -0,0 +1,71 @@
+/***********************************************************************************************//**
+ * \file cybsp_ramfunc.h
+ *
+ * \brief
+ * Placement of latency critical functions in SRAM.
+ *
+ ***************************************************************************************************
+ * \copyright
+ * Copyright 2023 Cypress Semiconductor Corporation (an Infineon company) or
+ * an affiliate of Cypress Semiconductor Corporation
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ **************************************************************************************************/
+
+#pragma once
+
+#include "cy_syslib.h"
+
+#if defined(__cplusplus)
+extern "C" {
+#endif
+
+/**
+ * \addtogroup group_bsp_ramfunc RAM Functions
+ * \{
+ * Code executed from flash is subject to the flash wait states at high CLK_HF0 frequencies and
+ * to contention with the CM0+ on the flash controller. When CYBSP_RAMFUNC_ISR is defined, the
+ * functions wrapped in \ref CYBSP_RAMFUNC_BEGIN / \ref CYBSP_RAMFUNC_END are placed in the
+ * .cy_ramfunc section that the startup code copies to SRAM together with the initialized data.
+ * Without the define the macros expand to nothing, so hot paths can be tagged unconditionally.
+ *
+ * The BSP tags the system IPC pipe interrupt handler (Cy_SysIpcPipeIsrCm4) and the
+ * \ref group_bsp_ipc_channel doorbell handler. The vector table is always copied to SRAM by the
+ * startup code. Functions called from a relocated function stay in flash unless they are tagged
+ * as well: the PDL IPC pipe and driver calls made by both handlers (Cy_IPC_Pipe_ExecuteCallback,
+ * Cy_IPC_Drv_LockRelease) and the registered callbacks still execute from flash, so the option
+ * shortens the handler entry but does not by itself remove the flash contention from the IPC
+ * latency. Code inside prebuilt or separately built libraries, such as the PDL IPC drivers and
+ * the HAL SDIO and UART handlers, cannot be tagged from the BSP; with GCC it can be moved by
+ * adding its object or function sections (e.g. `*cy_ipc_pipe.o(.text*)`, `*cy_ipc_drv.o(.text*)`
+ * or `*(.text._cyhal_uart_irq_handler)`) next to `.cy_ramfunc*` in the .data output section of
+ * the linker script.
+ */
+
+#if defined(CYBSP_RAMFUNC_ISR)
+/** Starts the definition of a function that executes from SRAM */
+#define CYBSP_RAMFUNC_BEGIN         CY_RAMFUNC_BEGIN
+/** Ends the definition of a function that executes from SRAM */
+#define CYBSP_RAMFUNC_END           CY_RAMFUNC_END
+#else
+#define CYBSP_RAMFUNC_BEGIN
+#define CYBSP_RAMFUNC_END
+#endif
+
+/** \} group_bsp_ramfunc */
+
+#ifdef __cplusplus
+}
+#endif // __cplusplus
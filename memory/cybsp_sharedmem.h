@@ -0,0 +1,70 @@
+/***********************************************************************************************//**
+ * \file cybsp_sharedmem.h
+ *
+ * \brief
+ * Location of the SRAM region shared with the other core.
+ *
+ ***************************************************************************************************
+ * \copyright
+ * Copyright 2023 Cypress Semiconductor Corporation (an Infineon company) or
+ * an affiliate of Cypress Semiconductor Corporation
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ **************************************************************************************************/
+
+#pragma once
+
+#include "cy_syslib.h"
+
+#if defined(__cplusplus)
+extern "C" {
+#endif
+
+/**
+ * \addtogroup group_bsp_sharedmem Shared Memory
+ * \{
+ * The linker scripts of all toolchains can reserve the end of the CM4 SRAM (below the 2 KB
+ * reserved for system use) for data shared with the other core, such as inter-core packet pools
+ * and mailboxes. The size is set with the CYBSP_SHAREDMEM_SIZE make variable and is taken from the
+ * application RAM; it defaults to 32 KB when CYBSP_IPC_CHANNEL is defined and to 0 otherwise, see
+ * bsp.mk. The region lies outside the SRAM used by the network processor image, so both images
+ * can agree on a fixed address, and it is never initialized by the startup code: the core that
+ * owns an object initializes it explicitly.
+ *
+ * Objects are placed there with \ref CYBSP_SECTION_SHAREDMEM. The CM4 has no data cache, so no
+ * cache maintenance is needed when the other core accesses the region.
+ */
+
+#if !defined(CYBSP_SHAREDMEM_SIZE)
+/** Size of the shared SRAM region in bytes. Passed by bsp.mk from the CYBSP_SHAREDMEM_SIZE make
+ * variable, which also sizes the region in the linker scripts. */
+#define CYBSP_SHAREDMEM_SIZE        (0UL)
+#endif
+/** Start address of the shared SRAM region, just below the 2 KB reserved for system use. */
+#define CYBSP_SHAREDMEM_START       (0x080FF800UL - (uint32_t)(CYBSP_SHAREDMEM_SIZE))
+
+/** Places a variable in the shared SRAM region, aligned to 32 bytes. */
+#if defined(__APPLE__) && defined(__clang__)
+#define CYBSP_SECTION_SHAREDMEM     __attribute__((section("__SHAREDMEM,__cy_sharedmem"))) \
+                                    CY_ALIGN(32)
+#else
+#define CYBSP_SECTION_SHAREDMEM     CY_SECTION(".cy_sharedmem") CY_ALIGN(32)
+#endif
+
+/** \} group_bsp_sharedmem */
+
+#ifdef __cplusplus
+}
+#endif // __cplusplus
@@ -0,0 +1,115 @@
+/***********************************************************************************************//**
+ * \file cybsp_warm_boot.c
+ *
+ * Description:
+ * Classifies every boot as warm or cold from the reset cause and retained RAM.
+ *
+ ***************************************************************************************************
+ * \copyright
+ * Copyright 2023 Cypress Semiconductor Corporation (an Infineon company) or
+ * an affiliate of Cypress Semiconductor Corporation
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ **************************************************************************************************/
+
+#if defined(CYBSP_WARM_BOOT)
+
+#include "cy_device_headers.h"
+#include "cy_syslib.h"
+#include "cybsp_warm_boot.h"
+
+#if defined(__cplusplus)
+extern "C" {
+#endif
+
+#define CYBSP_WARM_BOOT_MAGIC       (0x5741524Du)
+
+// Reset causes that keep the SRAM contents
+#define CYBSP_WARM_BOOT_CAUSES      (CY_SYSLIB_RESET_SOFT | CY_SYSLIB_RESET_HWWDT | \
+                                     CY_SYSLIB_RESET_SWWDT0 | CY_SYSLIB_RESET_SWWDT1 | \
+                                     CY_SYSLIB_RESET_SWWDT2 | CY_SYSLIB_RESET_SWWDT3)
+
+// Everything in here is written before the startup code has initialized RAM on some toolchains
+CYBSP_SECTION_RETAINED static cybsp_warm_boot_info_t cybsp_warm_boot_info;
+// Written by cybsp_warm_boot_reset() for the next boot
+CYBSP_SECTION_RETAINED static uint32_t               cybsp_warm_boot_next_code;
+
+//--------------------------------------------------------------------------------------------------
+// cybsp_warm_boot_early_init
+//--------------------------------------------------------------------------------------------------
+bool cybsp_warm_boot_early_init(void)
+{
+    // The reset cause is left for the application to read and clear
+    cybsp_warm_boot_info_t* info   = &cybsp_warm_boot_info;
+    uint32_t                reason = Cy_SysLib_GetResetReason();
+
+    bool valid = (CYBSP_WARM_BOOT_MAGIC == info->magic) &&
+                 (~CYBSP_WARM_BOOT_MAGIC == info->magic_inv);
+    info->warm = valid && (0u != (reason & CYBSP_WARM_BOOT_CAUSES));
+
+    if (info->warm)
+    {
+        info->boot_count++;
+        info->warm_count++;
+        info->reset_code = cybsp_warm_boot_next_code;
+    }
+    else
+    {
+        info->magic      = CYBSP_WARM_BOOT_MAGIC;
+        info->magic_inv  = ~CYBSP_WARM_BOOT_MAGIC;
+        info->boot_count = 1u;
+        info->warm_count = 0u;
+        info->reset_code = 0u;
+    }
+    info->reset_reason        = reason;
+    cybsp_warm_boot_next_code = 0u;
+    return info->warm;
+}
+
+
+//--------------------------------------------------------------------------------------------------
+// cybsp_warm_boot_is_warm
+//--------------------------------------------------------------------------------------------------
+bool cybsp_warm_boot_is_warm(void)
+{
+    return cybsp_warm_boot_info.warm;
+}
+
+
+//--------------------------------------------------------------------------------------------------
+// cybsp_warm_boot_get_info
+//--------------------------------------------------------------------------------------------------
+const cybsp_warm_boot_info_t* cybsp_warm_boot_get_info(void)
+{
+    return &cybsp_warm_boot_info;
+}
+
+
+//--------------------------------------------------------------------------------------------------
+// cybsp_warm_boot_reset
+//--------------------------------------------------------------------------------------------------
+void cybsp_warm_boot_reset(uint32_t code)
+{
+    cybsp_warm_boot_next_code = code;
+    __DSB();
+    NVIC_SystemReset();
+}
+
+
+#if defined(__cplusplus)
+}
+#endif
+
+#endif // defined(CYBSP_WARM_BOOT)
@@ -0,0 +1,128 @@
+/***********************************************************************************************//**
+ * \file cybsp_warm_boot.h
+ *
+ * \brief
+ * Detection of warm (software and watchdog) resets and state retained across them.
+ *
+ ***************************************************************************************************
+ * \copyright
+ * Copyright 2023 Cypress Semiconductor Corporation (an Infineon company) or
+ * an affiliate of Cypress Semiconductor Corporation
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ **************************************************************************************************/
+
+#pragma once
+
+#include <stdbool.h>
+#include <stdint.h>
+#include "cy_syslib.h"
+
+#if defined(__cplusplus)
+extern "C" {
+#endif
+
+/**
+ * \addtogroup group_bsp_warm_boot Warm Boot
+ * \{
+ * SRAM keeps its contents through a software reset and a watchdog reset, but every reset of this
+ * device is a system reset: the clock tree, the peripherals and the CM0+ restart as well, so
+ * SystemInit() has to redo the IPC semaphore and pipe setup (the CM0+ side is new) and
+ * cybsp_init() the clock configuration. What a warm boot can avoid is the application rebuilding
+ * state it already had, such as Wi-Fi credentials, connection parameters or calibration results.
+ *
+ * When CYBSP_WARM_BOOT is defined, the boot is classified first thing (in Reset_Handler with
+ * GCC_ARM, at the start of SystemInit() with the other toolchains) from the reset cause and a
+ * header in retained RAM. Variables tagged with \ref CYBSP_SECTION_RETAINED are placed in the
+ * .noinit section, which the startup code of every toolchain neither copies nor zeroes. After a
+ * cold boot (power-on, XRES or brown-out) their content is undefined; \ref cybsp_warm_boot_is_warm
+ * tells the application whether it can use them as they are.
+ *
+ * Variables tagged with \ref CYBSP_SECTION_WARM_BSS behave like .bss after a cold boot and keep
+ * their content after a warm boot. With GCC_ARM they are placed in a separate section that
+ * Reset_Handler only clears on a cold boot, so large zero-initialized buffers such as caches or
+ * logs cost no clearing time on a watchdog recovery. With the other toolchains the C library
+ * initializes RAM before SystemInit() runs, so the tag has no effect there and they are ordinary
+ * .bss variables. Apart from this, a warm boot takes as long as a cold boot.
+ *
+ * The reset cause registers are only read, never cleared, so Cy_SysLib_GetResetReason() and
+ * cyhal_system_get_reset_reason() keep working for the application. As the causes accumulate until
+ * they are cleared, an application that uses them should clear them with
+ * Cy_SysLib_ClearResetReason() once it has handled them.
+ *
+ * \ref cybsp_warm_boot_reset records a reason code for the next boot before resetting, so a
+ * watchdog driven recovery can tell why it happened.
+ */
+
+#if defined(CYBSP_WARM_BOOT)
+
+/** Places a variable in RAM retained across warm resets. */
+#define CYBSP_SECTION_RETAINED  CY_NOINIT
+
+#if defined(__GNUC__) && !defined(__ARMCC_VERSION) && !defined(__clang__)
+/** Reset_Handler classifies the boot, before RAM is initialized (GCC_ARM) */
+#define CYBSP_WARM_BOOT_IN_RESET_HANDLER
+/** Places a variable in .bss that is only cleared on a cold boot (GCC_ARM, plain .bss otherwise) */
+#define CYBSP_SECTION_WARM_BSS  CY_SECTION(".cy_warm_bss")
+#else
+#define CYBSP_SECTION_WARM_BSS
+#endif
+
+/** Boot information kept in retained RAM */
+typedef struct
+{
+    uint32_t magic;             /**< Marks the header as valid, BSP managed */
+    uint32_t magic_inv;         /**< Complement of magic, BSP managed */
+    uint32_t boot_count;        /**< Boots since the last cold boot, including this one */
+    uint32_t warm_count;        /**< Warm boots since the last cold boot */
+    uint32_t reset_reason;      /**< Cy_SysLib_GetResetReason() of the last reset */
+    uint32_t reset_code;        /**< Code passed to \ref cybsp_warm_boot_reset, 0 otherwise */
+    bool     warm;              /**< The current boot is a warm boot */
+} cybsp_warm_boot_info_t;
+
+/**
+ * \brief Records the reset cause and validates the retained header.
+ * Called once per boot by Reset_Handler (GCC_ARM) or SystemInit(), before RAM is initialized, so
+ * it only touches retained RAM.
+ * \returns true for a warm boot, false for a cold boot
+ */
+bool cybsp_warm_boot_early_init(void);
+
+/**
+ * \brief Returns whether the current boot followed a software or watchdog reset with retained RAM
+ *        intact.
+ * \returns true for a warm boot, false for a cold boot
+ */
+bool cybsp_warm_boot_is_warm(void);
+
+/**
+ * \brief Returns the boot information.
+ * \returns Pointer to the information in retained RAM
+ */
+const cybsp_warm_boot_info_t* cybsp_warm_boot_get_info(void);
+
+/**
+ * \brief Resets the device; the next boot is warm and reports the code.
+ * \param code Application defined reason, reported in \ref cybsp_warm_boot_info_t::reset_code
+ */
+void cybsp_warm_boot_reset(uint32_t code);
+
+#endif // defined(CYBSP_WARM_BOOT)
+
+/** \} group_bsp_warm_boot */
+
+#ifdef __cplusplus
+}
+#endif // __cplusplus
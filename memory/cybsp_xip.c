@@ -0,0 +1,353 @@
+/***********************************************************************************************//**
+ * \file cybsp_xip.c
+ *
+ * Description:
+ * Early SMIF initialization for execute-in-place from the on-board QSPI flash.
+ *
+ ***************************************************************************************************
+ * \copyright
+ * Copyright 2023 Cypress Semiconductor Corporation (an Infineon company) or
+ * an affiliate of Cypress Semiconductor Corporation
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ **************************************************************************************************/
+
+#if defined(CYBSP_XIP)
+
+#include <stdbool.h>
+#include "cy_device_headers.h"
+#include "cy_gpio.h"
+#include "cy_sysclk.h"
+#include "cy_syspm.h"
+#include "cy_smif.h"
+#include "cy_smif_memslot.h"
+#include "cycfg_qspi_memslot.h"
+#include "cybsp.h"
+#if defined(CY_USING_HAL)
+#include "cyhal_hwmgr.h"
+#include "cyhal_dma.h"
+#endif
+
+#if defined(__cplusplus)
+extern "C" {
+#endif
+
+#ifndef CYBSP_XIP_TIMEOUT_US
+    #define CYBSP_XIP_TIMEOUT_US        (1000u)
+#endif
+// Setting the non-volatile quad enable bit is a status register write (up to 500 ms)
+#ifndef CYBSP_XIP_QE_TIMEOUT_US
+    #define CYBSP_XIP_QE_TIMEOUT_US     (500000u)
+#endif
+
+#define CYBSP_XIP_CLK_HF                (2u)
+#define CYBSP_XIP_PORT                  (GPIO_PRT11)
+#define CYBSP_XIP_PORT_NUM              (11u)
+#define CYBSP_XIP_PIN_COUNT             (6u)
+// Elements per transfer, the X loop limit of the DMA block the HAL allocated. Larger lengths would
+// make the HAL split the transfer into a 2D one, which needs a length divisible by the X count.
+#define CYBSP_XIP_DMAC_CHUNK            (65536u)
+#define CYBSP_XIP_DW_CHUNK              (256u)
+
+typedef struct
+{
+    uint8_t         pin;
+    uint8_t         drive_mode;
+    en_hsiom_sel_t  hsiom;
+} cybsp_xip_pin_t;
+
+// CYBSP_QSPI_SS, CYBSP_QSPI_D3..D0 and CYBSP_QSPI_SCK in design.modus
+static const cybsp_xip_pin_t cybsp_xip_pins[CYBSP_XIP_PIN_COUNT] =
+{
+    { 2u, CY_GPIO_DM_STRONG_IN_OFF, P11_2_SMIF_SPI_SELECT0 },
+    { 3u, CY_GPIO_DM_STRONG,        P11_3_SMIF_SPI_DATA3   },
+    { 4u, CY_GPIO_DM_STRONG,        P11_4_SMIF_SPI_DATA2   },
+    { 5u, CY_GPIO_DM_STRONG,        P11_5_SMIF_SPI_DATA1   },
+    { 6u, CY_GPIO_DM_STRONG,        P11_6_SMIF_SPI_DATA0   },
+    { 7u, CY_GPIO_DM_STRONG,        P11_7_SMIF_SPI_CLK     }
+};
+
+static const cy_stc_smif_config_t cybsp_xip_smif_config =
+{
+    .mode          = (uint32_t)CY_SMIF_NORMAL,
+    .deselectDelay = 1u,
+    .rxClockSel    = (uint32_t)CY_SMIF_SEL_INV_INTERNAL_CLK,
+    .blockEvent    = (uint32_t)CY_SMIF_BUS_ERROR
+};
+
+// Written by SystemInit(), which runs before the startup code initializes RAM on some toolchains
+static CY_NOINIT cy_stc_smif_context_t cybsp_xip_context;
+static CY_NOINIT cy_rslt_t             cybsp_xip_status;
+static CY_NOINIT cybsp_xip_cache_profile_t cybsp_xip_cache_profile;
+// design.cyqspi keeps slot 0 in command mode; the memory mapped setup is applied on these copies
+static CY_NOINIT cy_stc_smif_mem_config_t   cybsp_xip_mem_config;
+static CY_NOINIT cy_stc_smif_mem_config_t*  cybsp_xip_mem_configs[1];
+static CY_NOINIT cy_stc_smif_block_config_t cybsp_xip_block_config;
+
+#if defined(CY_USING_HAL)
+static cyhal_dma_t cybsp_xip_dma;
+static bool        cybsp_xip_dma_allocated = false;
+#endif
+
+//--------------------------------------------------------------------------------------------------
+// cybsp_xip_apply_cache_profile
+//--------------------------------------------------------------------------------------------------
+static void cybsp_xip_apply_cache_profile(cybsp_xip_cache_profile_t profile)
+{
+    uint32_t savedIntrStatus = Cy_SysLib_EnterCriticalSection();
+
+    (void)Cy_SMIF_CachePrefetchingDisable(SMIF0, CY_SMIF_CACHE_BOTH);
+    (void)Cy_SMIF_CacheDisable(SMIF0, CY_SMIF_CACHE_BOTH);
+    if (CYBSP_XIP_CACHE_UNCACHED != profile)
+    {
+        (void)Cy_SMIF_CacheInvalidate(SMIF0, CY_SMIF_CACHE_BOTH);
+        (void)Cy_SMIF_CacheEnable(SMIF0, CY_SMIF_CACHE_BOTH);
+        if (CYBSP_XIP_CACHE_STREAMING == profile)
+        {
+            (void)Cy_SMIF_CachePrefetchingEnable(SMIF0, CY_SMIF_CACHE_BOTH);
+        }
+    }
+    cybsp_xip_cache_profile = profile;
+
+    Cy_SysLib_ExitCriticalSection(savedIntrStatus);
+}
+
+
+
+//--------------------------------------------------------------------------------------------------
+// cybsp_xip_map_slot
+//--------------------------------------------------------------------------------------------------
+static void cybsp_xip_map_slot(void)
+{
+    cybsp_xip_mem_config               = *smifMemConfigs[0];
+    cybsp_xip_mem_config.flags        |= CY_SMIF_FLAG_MEMORY_MAPPED;
+    cybsp_xip_mem_config.baseAddress   = CYBSP_XIP_START;
+    cybsp_xip_mem_config.memMappedSize = CYBSP_XIP_SIZE;
+
+    cybsp_xip_mem_configs[0]         = &cybsp_xip_mem_config;
+    cybsp_xip_block_config           = smifBlockConfig;
+    cybsp_xip_block_config.memCount  = 1u;
+    cybsp_xip_block_config.memConfig = cybsp_xip_mem_configs;
+}
+
+
+//--------------------------------------------------------------------------------------------------
+// cybsp_xip_enable_quad
+//--------------------------------------------------------------------------------------------------
+static cy_en_smif_status_t cybsp_xip_enable_quad(void)
+{
+    bool                isQuadEnabled = false;
+    cy_en_smif_status_t status        =
+        Cy_SMIF_MemIsQuadEnabled(SMIF0, &cybsp_xip_mem_config, &isQuadEnabled,
+                                 &cybsp_xip_context);
+
+    // The bit is non-volatile, so this only happens once per board
+    if ((CY_SMIF_SUCCESS == status) && !isQuadEnabled)
+    {
+        status = Cy_SMIF_MemEnableQuadMode(SMIF0, &cybsp_xip_mem_config, CYBSP_XIP_QE_TIMEOUT_US,
+                                           &cybsp_xip_context);
+    }
+    return status;
+}
+
+
+//--------------------------------------------------------------------------------------------------
+// cybsp_xip_early_init
+//--------------------------------------------------------------------------------------------------
+void cybsp_xip_early_init(void)
+{
+    // CLK_HF2 is disabled out of reset. SMIF runs from the IMO until cybsp_init() applies the
+    // design.modus clock configuration.
+    if (!Cy_SysClk_ClkHfIsEnabled(CYBSP_XIP_CLK_HF))
+    {
+        (void)Cy_SysClk_ClkHfSetSource(CYBSP_XIP_CLK_HF, CY_SYSCLK_CLKHF_IN_CLKPATH0);
+        (void)Cy_SysClk_ClkHfSetDivider(CYBSP_XIP_CLK_HF, CY_SYSCLK_CLKHF_NO_DIVIDE);
+        (void)Cy_SysClk_ClkHfEnable(CYBSP_XIP_CLK_HF);
+    }
+
+    for (uint32_t i = 0u; i < CYBSP_XIP_PIN_COUNT; i++)
+    {
+        Cy_GPIO_Pin_FastInit(CYBSP_XIP_PORT, cybsp_xip_pins[i].pin, cybsp_xip_pins[i].drive_mode,
+                             1u, cybsp_xip_pins[i].hsiom);
+    }
+
+    cy_en_smif_status_t status =
+        Cy_SMIF_Init(SMIF0, &cybsp_xip_smif_config, CYBSP_XIP_TIMEOUT_US, &cybsp_xip_context);
+    if (CY_SMIF_SUCCESS == status)
+    {
+        Cy_SMIF_SetDataSelect(SMIF0, CY_SMIF_SLAVE_SELECT_0, CY_SMIF_DATA_SEL0);
+        Cy_SMIF_Enable(SMIF0, &cybsp_xip_context);
+        cybsp_xip_map_slot();
+        status = Cy_SMIF_Memslot_Init(SMIF0, &cybsp_xip_block_config, &cybsp_xip_context);
+    }
+    if (CY_SMIF_SUCCESS == status)
+    {
+        status = cybsp_xip_enable_quad();
+    }
+    if (CY_SMIF_SUCCESS == status)
+    {
+        cybsp_xip_apply_cache_profile(CYBSP_XIP_CACHE_BOOT_PROFILE);
+        Cy_SMIF_SetMode(SMIF0, CY_SMIF_MEMORY);
+    }
+
+    cybsp_xip_status = (CY_SMIF_SUCCESS == status) ? CY_RSLT_SUCCESS : CYBSP_RSLT_ERR_XIP_INIT;
+}
+
+
+//--------------------------------------------------------------------------------------------------
+// cybsp_xip_init
+//--------------------------------------------------------------------------------------------------
+cy_rslt_t cybsp_xip_init(void)
+{
+    static cy_stc_syspm_callback_params_t cybsp_xip_pm_callback_param =
+    {
+        .base    = SMIF0,
+        .context = &cybsp_xip_context
+    };
+    static cy_stc_syspm_callback_t        cybsp_xip_pm_callback       =
+    {
+        .callback       = &Cy_SMIF_DeepSleepCallback,
+        .type           = CY_SYSPM_DEEPSLEEP,
+        .callbackParams = &cybsp_xip_pm_callback_param
+    };
+
+    cy_rslt_t result = cybsp_xip_status;
+    if ((CY_RSLT_SUCCESS == result) && !Cy_SysPm_RegisterCallback(&cybsp_xip_pm_callback))
+    {
+        result = CYBSP_RSLT_ERR_XIP_INIT;
+    }
+
+    #if defined(CY_USING_HAL)
+    const cyhal_resource_inst_t smif = { .type = CYHAL_RSC_SMIF, .block_num = 0u };
+    if (CY_RSLT_SUCCESS == result)
+    {
+        result = cyhal_hwmgr_reserve(&smif);
+    }
+    for (uint32_t i = 0u; (CY_RSLT_SUCCESS == result) && (i < CYBSP_XIP_PIN_COUNT); i++)
+    {
+        const cyhal_resource_inst_t pin =
+        {
+            .type        = CYHAL_RSC_GPIO,
+            .block_num   = CYBSP_XIP_PORT_NUM,
+            .channel_num = cybsp_xip_pins[i].pin
+        };
+        result = cyhal_hwmgr_reserve(&pin);
+    }
+    #endif
+    return result;
+}
+
+
+//--------------------------------------------------------------------------------------------------
+// cybsp_xip_get_context
+//--------------------------------------------------------------------------------------------------
+cy_stc_smif_context_t* cybsp_xip_get_context(void)
+{
+    return &cybsp_xip_context;
+}
+
+
+//--------------------------------------------------------------------------------------------------
+// cybsp_xip_set_cache_profile
+//--------------------------------------------------------------------------------------------------
+cy_rslt_t cybsp_xip_set_cache_profile(cybsp_xip_cache_profile_t profile)
+{
+    if (profile >= CYBSP_XIP_CACHE_PROFILE_COUNT)
+    {
+        return CYBSP_RSLT_ERR_XIP_BAD_ARG;
+    }
+    cybsp_xip_apply_cache_profile(profile);
+    return CY_RSLT_SUCCESS;
+}
+
+
+//--------------------------------------------------------------------------------------------------
+// cybsp_xip_get_cache_profile
+//--------------------------------------------------------------------------------------------------
+cybsp_xip_cache_profile_t cybsp_xip_get_cache_profile(void)
+{
+    return cybsp_xip_cache_profile;
+}
+
+
+#if defined(CY_USING_HAL)
+//--------------------------------------------------------------------------------------------------
+// cybsp_xip_dma_read
+//--------------------------------------------------------------------------------------------------
+cy_rslt_t cybsp_xip_dma_read(void* dst, const void* src, size_t length)
+{
+    uint32_t src_addr = (uint32_t)src;
+    if ((NULL == dst) || (src_addr < CYBSP_XIP_START) ||
+        (src_addr >= (CYBSP_XIP_START + CYBSP_XIP_SIZE)) ||
+        (length > (CYBSP_XIP_START + CYBSP_XIP_SIZE - src_addr)))
+    {
+        return CYBSP_RSLT_ERR_XIP_BAD_ARG;
+    }
+
+    cy_rslt_t result = CY_RSLT_SUCCESS;
+    if (!cybsp_xip_dma_allocated)
+    {
+        result = cyhal_dma_init(&cybsp_xip_dma, CYHAL_DMA_PRIORITY_DEFAULT,
+                                CYHAL_DMA_DIRECTION_MEM2MEM);
+        cybsp_xip_dma_allocated = (CY_RSLT_SUCCESS == result);
+    }
+
+    uint32_t dst_addr = (uint32_t)dst;
+    uint32_t width    = (0u == ((src_addr | dst_addr | length) & 3u)) ? 4u : 1u;
+    uint32_t chunk    = (CYHAL_RSC_DW == cybsp_xip_dma.resource.type)
+        ? CYBSP_XIP_DW_CHUNK
+        : CYBSP_XIP_DMAC_CHUNK;
+    while ((CY_RSLT_SUCCESS == result) && (0u != length))
+    {
+        uint32_t          count = length / width;
+        cyhal_dma_cfg_t   cfg   =
+        {
+            .src_addr       = src_addr,
+            .src_increment  = 1,
+            .dst_addr       = dst_addr,
+            .dst_increment  = 1,
+            .transfer_width = width * 8u,
+            .length         = (count > chunk) ? chunk : count,
+            .burst_size     = 0u,
+            .action         = CYHAL_DMA_TRANSFER_FULL
+        };
+        result = cyhal_dma_configure(&cybsp_xip_dma, &cfg);
+        if (CY_RSLT_SUCCESS == result)
+        {
+            result = cyhal_dma_start_transfer(&cybsp_xip_dma);
+        }
+        if (CY_RSLT_SUCCESS == result)
+        {
+            while (cyhal_dma_is_busy(&cybsp_xip_dma))
+            {
+            }
+            uint32_t bytes = cfg.length * width;
+            src_addr += bytes;
+            dst_addr += bytes;
+            length   -= bytes;
+        }
+    }
+    return result;
+}
+
+
+#endif // defined(CY_USING_HAL)
+
+
+#if defined(__cplusplus)
+}
+#endif
+
+#endif // defined(CYBSP_XIP)
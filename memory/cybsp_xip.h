@@ -0,0 +1,155 @@
+/***********************************************************************************************//**
+ * \file cybsp_xip.h
+ *
+ * \brief
+ * Memory mapped (execute-in-place) access to the on-board S25FL512S QSPI flash.
+ *
+ ***************************************************************************************************
+ * \copyright
+ * Copyright 2023 Cypress Semiconductor Corporation (an Infineon company) or
+ * an affiliate of Cypress Semiconductor Corporation
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ **************************************************************************************************/
+
+#pragma once
+
+#include <stddef.h>
+#include "cy_result.h"
+#include "cy_syslib.h"
+#if defined(CYBSP_XIP)
+#include "cy_smif.h"
+#endif
+
+#if defined(__cplusplus)
+extern "C" {
+#endif
+
+/**
+ * \addtogroup group_bsp_xip Execute In Place
+ * \{
+ * When CYBSP_XIP is defined, SystemInit() maps the whole 64 MB S25FL512S on slave select 0 at
+ * \ref CYBSP_XIP_START in quad I/O mode. The slot configuration of the QSPI Configurator file
+ * (design.cyqspi) is left in command mode; the memory mapped flag, base address and size are
+ * applied on a copy of it before SMIF is switched to memory mode. Code and read-only data placed
+ * with \ref CYBSP_SECTION_XIP can be used from then on, including by static initializers. The
+ * linker scripts place the .cy_xip section in the external flash and the programmer writes it
+ * through the configuration stored in the TOC2.
+ *
+ * Large read-only assets such as certificate bundles, model weights or radio firmware can be
+ * tagged unconditionally: without CYBSP_XIP the macro expands to nothing and the assets stay in
+ * internal flash.
+ *
+ * \note SystemInit() runs before the startup code initializes RAM on some toolchains, so the early
+ * initialization only touches SMIF, the QSPI pins and CLK_HF2. \ref cybsp_init completes the setup
+ * by registering the SMIF deep sleep callback and reserving SMIF and its pins in the HAL hardware
+ * manager, so HAL QSPI drivers cannot reconfigure the interface underneath running XIP code.
+ * \note The SMIF block of this device transfers data on single clock edges only; the DDR read
+ * modes of the S25FL512S are not used.
+ *
+ * SMIF has a fast cache for the CM4 and a slow cache for the CM0+ and DMA, each with optional
+ * prefetching of the following cache line. \ref cybsp_xip_set_cache_profile selects a setup
+ * suited to the workload, and \ref cybsp_xip_dma_read copies assets into SRAM with a DMA channel
+ * so the CPU is not stalled on the flash. \ref group_bsp_xip_bench measures both.
+ */
+
+/** Start address of the memory mapped QSPI flash */
+#define CYBSP_XIP_START             (0x18000000UL)
+/** Size of the memory mapped QSPI flash in bytes */
+#define CYBSP_XIP_SIZE              (0x04000000UL)
+
+/** Places a function or constant in the memory mapped QSPI flash when CYBSP_XIP is defined. */
+#if !defined(CYBSP_XIP)
+#define CYBSP_SECTION_XIP
+#elif defined(__APPLE__) && defined(__clang__)
+#define CYBSP_SECTION_XIP           __attribute__((section("__XIP,__cy_xip")))
+#else
+#define CYBSP_SECTION_XIP           CY_SECTION(".cy_xip")
+#endif
+
+#if defined(CYBSP_XIP)
+
+/** SMIF cache setups, see \ref cybsp_xip_set_cache_profile */
+typedef enum
+{
+    CYBSP_XIP_CACHE_RANDOM_CODE,    /**< Caches enabled, no prefetch: code with frequent branches */
+    CYBSP_XIP_CACHE_STREAMING,      /**< Caches and prefetch enabled: sequential data streams */
+    CYBSP_XIP_CACHE_UNCACHED,       /**< Caches disabled: every access reads the flash */
+    CYBSP_XIP_CACHE_PROFILE_COUNT   /**< Number of profiles, not a valid profile */
+} cybsp_xip_cache_profile_t;
+
+#if !defined(CYBSP_XIP_CACHE_BOOT_PROFILE)
+/** Cache profile applied by SystemInit() */
+#define CYBSP_XIP_CACHE_BOOT_PROFILE    (CYBSP_XIP_CACHE_RANDOM_CODE)
+#endif
+
+/**
+ * \brief Initializes SMIF and switches the QSPI flash to memory mapped mode.
+ * Called from SystemInit(). Must not be called while code executes from the QSPI flash.
+ */
+void cybsp_xip_early_init(void);
+
+/**
+ * \brief Completes the XIP setup started by \ref cybsp_xip_early_init.
+ * Called by \ref cybsp_init.
+ * \returns CY_RSLT_SUCCESS if the QSPI flash is memory mapped, CYBSP_RSLT_ERR_XIP_INIT if the
+ *          early initialization failed, otherwise the error from the resource reservation
+ */
+cy_rslt_t cybsp_xip_init(void);
+
+/**
+ * \brief Returns the SMIF driver context used for the memory mapped flash.
+ * Needed to program or erase the QSPI flash with the Cy_SMIF_Memslot functions while no code
+ * executes from it. Switch back to memory mode with Cy_SMIF_SetMode() when done.
+ * \returns The SMIF context
+ */
+cy_stc_smif_context_t* cybsp_xip_get_context(void);
+
+/**
+ * \brief Selects the SMIF cache and prefetch setup.
+ * Both caches are invalidated. May be called while code executes from the QSPI flash.
+ * \param profile Cache profile to apply
+ * \returns CY_RSLT_SUCCESS if the profile was applied, CYBSP_RSLT_ERR_XIP_BAD_ARG if the profile
+ *          is invalid
+ */
+cy_rslt_t cybsp_xip_set_cache_profile(cybsp_xip_cache_profile_t profile);
+
+/**
+ * \brief Returns the active SMIF cache profile.
+ * \returns The profile last applied
+ */
+cybsp_xip_cache_profile_t cybsp_xip_get_cache_profile(void);
+
+#if defined(CY_USING_HAL)
+/**
+ * \brief Copies data from the memory mapped QSPI flash to SRAM with DMA.
+ * Allocates a DMA channel on first use and blocks until the copy is complete. 32-bit transfers
+ * are used when the addresses and the length are word aligned, byte transfers otherwise.
+ * \param dst    Destination in SRAM
+ * \param src    Source in the memory mapped QSPI flash
+ * \param length Number of bytes to copy
+ * \returns CY_RSLT_SUCCESS if the data was copied, CYBSP_RSLT_ERR_XIP_BAD_ARG if the source is not
+ *          within the memory mapped flash, otherwise the error from the DMA driver
+ */
+cy_rslt_t cybsp_xip_dma_read(void* dst, const void* src, size_t length);
+#endif
+
+#endif // defined(CYBSP_XIP)
+
+/** \} group_bsp_xip */
+
+#ifdef __cplusplus
+}
+#endif // __cplusplus
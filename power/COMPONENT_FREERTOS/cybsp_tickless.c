@@ -0,0 +1,123 @@
+/***********************************************************************************************//**
+ * \file cybsp_tickless.c
+ *
+ * Description:
+ * FreeRTOS tickless idle (vApplicationSleep) for the CM4 using the HAL LPTIMER.
+ *
+ ***************************************************************************************************
+ * \copyright
+ * Copyright 2023 Cypress Semiconductor Corporation (an Infineon company) or
+ * an affiliate of Cypress Semiconductor Corporation
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ **************************************************************************************************/
+
+#if defined(CYBSP_TICKLESS_IDLE)
+
+#include <stdbool.h>
+#include <stddef.h>
+#include "cy_device_headers.h"
+#include "cy_syslib.h"
+#include "cyhal_syspm.h"
+#include "FreeRTOS.h"
+#include "task.h"
+#include "cybsp_lptimer.h"
+#include "cybsp_tickless.h"
+
+#if defined(__cplusplus)
+extern "C" {
+#endif
+
+static cybsp_tickless_stats_t cybsp_tickless_stats;
+
+//--------------------------------------------------------------------------------------------------
+// vApplicationSleep
+//
+// Called by the FreeRTOS idle task with the scheduler suspended when nothing is ready to run for
+// at least configEXPECTED_IDLE_TIME_BEFORE_SLEEP ticks.
+//--------------------------------------------------------------------------------------------------
+void vApplicationSleep(TickType_t xExpectedIdleTime)
+{
+    // The shared LPTIMER is only reserved once the system first goes idle, unless another BSP
+    // feature already did
+    if (CY_RSLT_SUCCESS != cybsp_lptimer_init())
+    {
+        return;
+    }
+    cyhal_lptimer_t* timer = cybsp_lptimer_get();
+
+    uint32_t savedIntrStatus = Cy_SysLib_EnterCriticalSection();
+
+    // An interrupt may have made a task ready since the idle task decided to sleep
+    if (eAbortSleep != eTaskConfirmSleepModeStatus())
+    {
+        uint32_t desired_ms = (uint32_t)pdTICKS_TO_MS(xExpectedIdleTime);
+        uint32_t actual_ms  = 0u;
+        bool     deepsleep  = false;
+
+        // SysTick would otherwise wake the CPU from Sleep on every tick
+        SysTick->CTRL &= ~SysTick_CTRL_ENABLE_Msk;
+
+        if (desired_ms >= CYBSP_TICKLESS_DEEPSLEEP_MIN_MS)
+        {
+            // Fails without sleeping if Deep Sleep is locked or rejected by a PM callback
+            deepsleep = (CY_RSLT_SUCCESS ==
+                         cyhal_syspm_tickless_deepsleep(timer, desired_ms, &actual_ms));
+            if (deepsleep)
+            {
+                cybsp_tickless_stats.deepsleep_ms += actual_ms;
+            }
+        }
+        if (!deepsleep)
+        {
+            actual_ms = 0u;
+            if (CY_RSLT_SUCCESS ==
+                cyhal_syspm_tickless_sleep(timer, desired_ms, &actual_ms))
+            {
+                cybsp_tickless_stats.sleep_ms += actual_ms;
+            }
+        }
+        cybsp_tickless_stats.idle_count++;
+
+        // Never step past the expected idle time, FreeRTOS asserts on that
+        TickType_t actual_ticks = pdMS_TO_TICKS(actual_ms);
+        vTaskStepTick((actual_ticks < xExpectedIdleTime) ? actual_ticks : xExpectedIdleTime);
+
+        SysTick->VAL   = 0u;
+        SysTick->CTRL |= SysTick_CTRL_ENABLE_Msk;
+    }
+
+    Cy_SysLib_ExitCriticalSection(savedIntrStatus);
+}
+
+
+//--------------------------------------------------------------------------------------------------
+// cybsp_tickless_get_stats
+//--------------------------------------------------------------------------------------------------
+void cybsp_tickless_get_stats(cybsp_tickless_stats_t* stats)
+{
+    CY_ASSERT(NULL != stats);
+
+    uint32_t savedIntrStatus = Cy_SysLib_EnterCriticalSection();
+    *stats = cybsp_tickless_stats;
+    Cy_SysLib_ExitCriticalSection(savedIntrStatus);
+}
+
+
+#if defined(__cplusplus)
+}
+#endif
+
+#endif // defined(CYBSP_TICKLESS_IDLE)
@@ -0,0 +1,83 @@
+/***********************************************************************************************//**
+ * \file cybsp_tickless.h
+ *
+ * \brief
+ * FreeRTOS tickless idle using the LPTIMER (MCWDT) clocked from the WCO.
+ *
+ ***************************************************************************************************
+ * \copyright
+ * Copyright 2023 Cypress Semiconductor Corporation (an Infineon company) or
+ * an affiliate of Cypress Semiconductor Corporation
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ **************************************************************************************************/
+
+#pragma once
+
+#include <stdint.h>
+
+#if defined(__cplusplus)
+extern "C" {
+#endif
+
+/**
+ * \addtogroup group_bsp_tickless Tickless Idle
+ * \{
+ * When CYBSP_TICKLESS_IDLE is defined and the FREERTOS component is enabled, the BSP provides
+ * vApplicationSleep(), which FreeRTOS calls from the idle task when configUSE_TICKLESS_IDLE is
+ * set and portSUPPRESS_TICKS_AND_SLEEP() maps to it (as in the ModusToolbox FreeRTOSConfig.h
+ * template). It replaces the default weak implementation so that tickless idle works without a
+ * system idle mode in design.modus.
+ *
+ * For each idle period SysTick is stopped, the shared LPTIMER (\ref group_bsp_lptimer, an MCWDT
+ * counting CLK_LF, which is the WCO on this board) is programmed for the expected idle time and
+ * the CPU enters Deep Sleep through the HAL, so the SysClk power management callback restores the
+ * clocks on wakeup. If Deep Sleep is locked, rejected by a driver or the idle time is shorter than
+ * CYBSP_TICKLESS_DEEPSLEEP_MIN_MS, Sleep is used instead. On wakeup the RTOS tick count is
+ * advanced by the time actually spent idle.
+ *
+ * \note \ref cybsp_init permanently locks Deep Sleep unless the Device Configurator defines a
+ * system idle mode or CYBSP_SLEEP_POLICY is defined, so combine this option with
+ * CYBSP_SLEEP_POLICY to get Deep Sleep.
+ */
+
+#if !defined(CYBSP_TICKLESS_DEEPSLEEP_MIN_MS)
+/** Idle periods shorter than this use Sleep instead of Deep Sleep. */
+#define CYBSP_TICKLESS_DEEPSLEEP_MIN_MS     (2u)
+#endif
+
+#if defined(CYBSP_TICKLESS_IDLE)
+
+/** Time spent in each low power state by the idle task, see \ref cybsp_tickless_get_stats */
+typedef struct
+{
+    uint32_t sleep_ms;          /**< Total time spent in Sleep */
+    uint32_t deepsleep_ms;      /**< Total time spent in Deep Sleep */
+    uint32_t idle_count;        /**< Number of idle periods */
+} cybsp_tickless_stats_t;
+
+/**
+ * \brief Returns the time spent in Sleep and Deep Sleep by the idle task.
+ * \param stats Filled with the statistics
+ */
+void cybsp_tickless_get_stats(cybsp_tickless_stats_t* stats);
+
+#endif // defined(CYBSP_TICKLESS_IDLE)
+
+/** \} group_bsp_tickless */
+
+#ifdef __cplusplus
+}
+#endif // __cplusplus
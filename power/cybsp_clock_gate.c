@@ -0,0 +1,189 @@
+/***********************************************************************************************//**
+ * \file cybsp_clock_gate.c
+ *
+ * Description:
+ * Tracks the users of the peripheral clock dividers and disables dividers nobody uses.
+ *
+ ***************************************************************************************************
+ * \copyright
+ * Copyright 2023 Cypress Semiconductor Corporation (an Infineon company) or
+ * an affiliate of Cypress Semiconductor Corporation
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ **************************************************************************************************/
+
+#if defined(CYBSP_CLOCK_GATE)
+
+#include <stdbool.h>
+#include "cy_device_headers.h"
+#include "cy_syslib.h"
+#include "cy_sysclk.h"
+#include "cybsp.h"
+
+#if defined(__cplusplus)
+extern "C" {
+#endif
+
+// 16-bit dividers reserved for the network processor by cybsp_init()
+#define CYBSP_CLOCK_GATE_NP_DIV_16_COUNT    (2u)
+
+// Divider types in cy_en_divider_types_t order
+static const uint8_t cybsp_clock_gate_counts[] =
+{
+    PERI_DIV_8_NR, PERI_DIV_16_NR, PERI_DIV_16_5_NR, PERI_DIV_24_5_NR
+};
+
+#define CYBSP_CLOCK_GATE_DIV_COUNT \
+    (PERI_DIV_8_NR + PERI_DIV_16_NR + PERI_DIV_16_5_NR + PERI_DIV_24_5_NR)
+
+static uint8_t cybsp_clock_gate_users[CYBSP_CLOCK_GATE_DIV_COUNT];
+
+//--------------------------------------------------------------------------------------------------
+// cybsp_clock_gate_index
+//
+// Index of a divider in cybsp_clock_gate_users, or CYBSP_CLOCK_GATE_DIV_COUNT if it does not exist
+//--------------------------------------------------------------------------------------------------
+static uint32_t cybsp_clock_gate_index(cy_en_divider_types_t type, uint32_t num)
+{
+    uint32_t index = 0u;
+    if ((uint32_t)type >= CY_ARRAY_SIZE(cybsp_clock_gate_counts))
+    {
+        return CYBSP_CLOCK_GATE_DIV_COUNT;
+    }
+    for (uint32_t t = 0u; t < (uint32_t)type; t++)
+    {
+        index += cybsp_clock_gate_counts[t];
+    }
+    return (num < cybsp_clock_gate_counts[type]) ? (index + num) : CYBSP_CLOCK_GATE_DIV_COUNT;
+}
+
+
+//--------------------------------------------------------------------------------------------------
+// cybsp_clock_gate_is_connected
+//--------------------------------------------------------------------------------------------------
+static bool cybsp_clock_gate_is_connected(cy_en_divider_types_t type, uint32_t num)
+{
+    for (uint32_t dst = 0u; dst < PERI_CLOCK_NR; dst++)
+    {
+        uint32_t assigned = Cy_SysClk_PeriphGetAssignedDivider((en_clk_dst_t)dst);
+        if (((uint32_t)type == _FLD2VAL(PERI_CLOCK_CTL_TYPE_SEL, assigned)) &&
+            (num == _FLD2VAL(PERI_CLOCK_CTL_DIV_SEL, assigned)))
+        {
+            return true;
+        }
+    }
+    return false;
+}
+
+
+//--------------------------------------------------------------------------------------------------
+// cybsp_clock_gate_acquire
+//--------------------------------------------------------------------------------------------------
+cy_rslt_t cybsp_clock_gate_acquire(cy_en_divider_types_t type, uint32_t num)
+{
+    uint32_t index = cybsp_clock_gate_index(type, num);
+    if (CYBSP_CLOCK_GATE_DIV_COUNT == index)
+    {
+        return CYBSP_RSLT_ERR_CLOCK_GATE;
+    }
+
+    cy_rslt_t result          = CY_RSLT_SUCCESS;
+    uint32_t  savedIntrStatus = Cy_SysLib_EnterCriticalSection();
+    if (UINT8_MAX == cybsp_clock_gate_users[index])
+    {
+        result = CYBSP_RSLT_ERR_CLOCK_GATE;
+    }
+    else if (0u == cybsp_clock_gate_users[index]++)
+    {
+        (void)Cy_SysClk_PeriphEnableDivider(type, num);
+    }
+    Cy_SysLib_ExitCriticalSection(savedIntrStatus);
+
+    return result;
+}
+
+
+//--------------------------------------------------------------------------------------------------
+// cybsp_clock_gate_release
+//--------------------------------------------------------------------------------------------------
+cy_rslt_t cybsp_clock_gate_release(cy_en_divider_types_t type, uint32_t num)
+{
+    uint32_t index = cybsp_clock_gate_index(type, num);
+    if (CYBSP_CLOCK_GATE_DIV_COUNT == index)
+    {
+        return CYBSP_RSLT_ERR_CLOCK_GATE;
+    }
+
+    cy_rslt_t result          = CY_RSLT_SUCCESS;
+    uint32_t  savedIntrStatus = Cy_SysLib_EnterCriticalSection();
+    if (0u == cybsp_clock_gate_users[index])
+    {
+        result = CYBSP_RSLT_ERR_CLOCK_GATE;
+    }
+    else if (0u == --cybsp_clock_gate_users[index])
+    {
+        (void)Cy_SysClk_PeriphDisableDivider(type, num);
+    }
+    Cy_SysLib_ExitCriticalSection(savedIntrStatus);
+
+    return result;
+}
+
+
+//--------------------------------------------------------------------------------------------------
+// cybsp_clock_gate_get_users
+//--------------------------------------------------------------------------------------------------
+uint32_t cybsp_clock_gate_get_users(cy_en_divider_types_t type, uint32_t num)
+{
+    uint32_t index = cybsp_clock_gate_index(type, num);
+    return (CYBSP_CLOCK_GATE_DIV_COUNT == index) ? 0u : cybsp_clock_gate_users[index];
+}
+
+
+//--------------------------------------------------------------------------------------------------
+// cybsp_clock_gate_unused
+//--------------------------------------------------------------------------------------------------
+uint32_t cybsp_clock_gate_unused(void)
+{
+    uint32_t gated = 0u;
+
+    for (uint32_t t = 0u; t < CY_ARRAY_SIZE(cybsp_clock_gate_counts); t++)
+    {
+        cy_en_divider_types_t type  = (cy_en_divider_types_t)t;
+        uint32_t              first = (CY_SYSCLK_DIV_16_BIT == type)
+                                      ? CYBSP_CLOCK_GATE_NP_DIV_16_COUNT
+                                      : 0u;
+        for (uint32_t num = first; num < cybsp_clock_gate_counts[t]; num++)
+        {
+            uint32_t savedIntrStatus = Cy_SysLib_EnterCriticalSection();
+            if ((0u == cybsp_clock_gate_get_users(type, num)) &&
+                Cy_SysClk_PeriphGetDividerEnabled(type, num) &&
+                !cybsp_clock_gate_is_connected(type, num))
+            {
+                (void)Cy_SysClk_PeriphDisableDivider(type, num);
+                gated++;
+            }
+            Cy_SysLib_ExitCriticalSection(savedIntrStatus);
+        }
+    }
+    return gated;
+}
+
+
+#if defined(__cplusplus)
+}
+#endif
+
+#endif // defined(CYBSP_CLOCK_GATE)
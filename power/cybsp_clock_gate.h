@@ -0,0 +1,93 @@
+/***********************************************************************************************//**
+ * \file cybsp_clock_gate.h
+ *
+ * \brief
+ * Reference counted gating of the peripheral clock dividers.
+ *
+ ***************************************************************************************************
+ * \copyright
+ * Copyright 2023 Cypress Semiconductor Corporation (an Infineon company) or
+ * an affiliate of Cypress Semiconductor Corporation
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ **************************************************************************************************/
+
+#pragma once
+
+#include <stdint.h>
+#include "cy_result.h"
+#if defined(CYBSP_CLOCK_GATE)
+#include "cy_sysclk.h"
+#endif
+
+#if defined(__cplusplus)
+extern "C" {
+#endif
+
+/**
+ * \addtogroup group_bsp_clock_gate Clock Gating
+ * \{
+ * When CYBSP_CLOCK_GATE is defined, \ref cybsp_init disables every peripheral clock divider that
+ * the generated configuration left running without connecting it to a peripheral. Dividers 0 and
+ * 1 of the 16-bit dividers are used by the network processor image and are never touched.
+ *
+ * Code that drives a peripheral through the PDL can share a divider with
+ * \ref cybsp_clock_gate_acquire and \ref cybsp_clock_gate_release: the divider runs while at
+ * least one user holds it. A divider with users is never gated by \ref cybsp_clock_gate_unused.
+ * Dividers allocated by HAL drivers are enabled by the driver and disabled when it is freed, and
+ * the peripheral blocks themselves are enabled and disabled by their drivers in the same way.
+ */
+
+#if defined(CYBSP_CLOCK_GATE)
+
+/**
+ * \brief Adds a user of a divider and enables it for the first user.
+ * \param type Divider type
+ * \param num  Divider number
+ * \returns CY_RSLT_SUCCESS, or CYBSP_RSLT_ERR_CLOCK_GATE if the divider does not exist
+ */
+cy_rslt_t cybsp_clock_gate_acquire(cy_en_divider_types_t type, uint32_t num);
+
+/**
+ * \brief Removes a user of a divider and disables it when the last user is gone.
+ * \param type Divider type
+ * \param num  Divider number
+ * \returns CY_RSLT_SUCCESS, or CYBSP_RSLT_ERR_CLOCK_GATE if the divider does not exist or has no
+ *          user
+ */
+cy_rslt_t cybsp_clock_gate_release(cy_en_divider_types_t type, uint32_t num);
+
+/**
+ * \brief Returns the number of users of a divider.
+ * \param type Divider type
+ * \param num  Divider number
+ * \returns The user count, 0 for dividers that do not exist
+ */
+uint32_t cybsp_clock_gate_get_users(cy_en_divider_types_t type, uint32_t num);
+
+/**
+ * \brief Disables every enabled divider that has no user and drives no peripheral clock.
+ * Called by \ref cybsp_init. Can be called again after peripherals have been released.
+ * \returns The number of dividers that were disabled
+ */
+uint32_t cybsp_clock_gate_unused(void);
+
+#endif // defined(CYBSP_CLOCK_GATE)
+
+/** \} group_bsp_clock_gate */
+
+#ifdef __cplusplus
+}
+#endif // __cplusplus
@@ -0,0 +1,356 @@
+/***********************************************************************************************//**
+ * \file cybsp_clock_profile.c
+ *
+ * Description:
+ * Reprograms PLL0 and the clock dividers behind it to move between predefined operating points.
+ *
+ ***************************************************************************************************
+ * \copyright
+ * Copyright 2023 Cypress Semiconductor Corporation (an Infineon company) or
+ * an affiliate of Cypress Semiconductor Corporation
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ **************************************************************************************************/
+
+#include <stdbool.h>
+#include "cy_syslib.h"
+#include "cy_syspm.h"
+#include "cy_sysclk.h"
+#include "system_psoc6.h"
+#include "cybsp.h"
+
+#if defined(__cplusplus)
+extern "C" {
+#endif
+
+// Clock path driven by PLL0 in design.modus. Path 0 is the (disabled) FLL path, so while PLL0 is
+// being reprogrammed anything moved to path 0 runs directly from the IMO.
+#define CYBSP_CLOCK_PROFILE_PLL_PATH        (1u)
+
+#ifndef CYBSP_CLOCK_PROFILE_PLL_TIMEOUT_US
+    #define CYBSP_CLOCK_PROFILE_PLL_TIMEOUT_US  (10000u)
+#endif
+
+// The levels other than NOMINAL divide CLK_PERI/CLK_SLOW differently. That retimes the CM0+ and
+// the peripheral dividers reserved for the network processor image (div_16[0]/[1]), which cannot
+// be notified. Only the CM0P_SLEEP image, with no SCL network processor, tolerates it.
+#if defined(COMPONENT_CM0P_SLEEP) && !defined(COMPONENT_SCL)
+    #define CYBSP_CLOCK_PROFILE_RETIME_ALLOWED  (1)
+#else
+    #define CYBSP_CLOCK_PROFILE_RETIME_ALLOWED  (0)
+#endif
+
+#if defined(CYBSP_CLOCK_PROFILE_PERFORMANCE) && (0 == CYBSP_CLOCK_PROFILE_RETIME_ALLOWED)
+    #error "CYBSP_CLOCK_PROFILE_PERFORMANCE requires the CM0P_SLEEP image and no SCL component"
+#endif
+
+// Performance level applied by cybsp_init()
+#if defined(CYBSP_CLOCK_PROFILE_PERFORMANCE)
+    #define CYBSP_CLOCK_PROFILE_BOOT_LEVEL      (CYBSP_PERF_LEVEL_HIGH)
+#else
+    #define CYBSP_CLOCK_PROFILE_BOOT_LEVEL      (CYBSP_PERF_LEVEL_NOMINAL)
+#endif
+
+// CLK_HF instances sourced from PLL0 in design.modus
+static const uint32_t cybsp_clock_profile_hf[] = { 0u, 2u, 4u };
+
+typedef struct
+{
+    uint32_t                pll_hz;     // PLL0 output frequency
+    uint8_t                 peri_div;   // CLK_PERI divider, value written to the register (div - 1)
+    cy_en_clkhf_dividers_t  hf_div[CY_ARRAY_SIZE(cybsp_clock_profile_hf)];
+} cybsp_clock_profile_t;
+
+// Indexed by cybsp_perf_level_t. CLK_PERI and CLK_HF2/CLK_HF4 must stay at or below 100 MHz.
+static const cybsp_clock_profile_t cybsp_clock_profiles[] =
+{
+    // CYBSP_PERF_LEVEL_LOW, CLK_PERI limited to 25 MHz and CLK_HF to 50 MHz in ULP mode
+    { 50000000UL, 1u,
+      { CY_SYSCLK_CLKHF_NO_DIVIDE, CY_SYSCLK_CLKHF_DIVIDE_BY_2, CY_SYSCLK_CLKHF_NO_DIVIDE } },
+    // CYBSP_PERF_LEVEL_NOMINAL
+    { 100000000UL, 0u,
+      { CY_SYSCLK_CLKHF_NO_DIVIDE, CY_SYSCLK_CLKHF_DIVIDE_BY_2, CY_SYSCLK_CLKHF_NO_DIVIDE } },
+    // CYBSP_PERF_LEVEL_HIGH
+    { 150000000UL, 1u,
+      { CY_SYSCLK_CLKHF_NO_DIVIDE, CY_SYSCLK_CLKHF_DIVIDE_BY_2, CY_SYSCLK_CLKHF_DIVIDE_BY_2 } },
+};
+
+static cybsp_perf_level_t cybsp_perf_level = CYBSP_PERF_LEVEL_NOMINAL;
+static cybsp_clock_change_handler_t* cybsp_clock_change_handlers = NULL;
+
+//--------------------------------------------------------------------------------------------------
+// cybsp_clock_profile_notify
+//--------------------------------------------------------------------------------------------------
+static void cybsp_clock_profile_notify(cybsp_clock_change_event_t event, cybsp_perf_level_t from,
+                                       cybsp_perf_level_t to)
+{
+    for (cybsp_clock_change_handler_t* handler = cybsp_clock_change_handlers; NULL != handler;
+         handler = handler->next)
+    {
+        handler->callback(event, from, to, handler->arg);
+    }
+}
+
+
+//--------------------------------------------------------------------------------------------------
+// cybsp_clock_profile_apply
+//
+// Moves CLK_HF0/2/4 to the IMO, programs the dividers and PLL0 for the requested level, then moves
+// the clocks back to PLL0. Flash wait states are set for the faster of the old and new frequency
+// while switching and trimmed afterwards. The clock switches run with interrupts disabled so no
+// ISR observes an intermediate clock configuration. Waiting for the PLL to lock (up to
+// CYBSP_CLOCK_PROFILE_PLL_TIMEOUT_US) runs with interrupts enabled while the system runs from the
+// IMO, with SystemCoreClock matching it.
+//--------------------------------------------------------------------------------------------------
+static cy_rslt_t cybsp_clock_profile_apply(cybsp_perf_level_t level)
+{
+    const cybsp_clock_profile_t* profile = &cybsp_clock_profiles[level];
+    cy_rslt_t result   = CY_RSLT_SUCCESS;
+    bool      ulp_mode = Cy_SysPm_IsSystemUlp();
+    uint32_t  old_mhz  = CY_SYSLIB_DIV_ROUNDUP(Cy_SysClk_ClkHfGetFrequency(0u), 1000000UL);
+    uint32_t  new_mhz  = CY_SYSLIB_DIV_ROUNDUP(profile->pll_hz, 1000000UL);
+    bool      on_pll[CY_ARRAY_SIZE(cybsp_clock_profile_hf)];
+
+    uint32_t savedIntrStatus = Cy_SysLib_EnterCriticalSection();
+
+    Cy_SysLib_SetWaitStates(ulp_mode, (old_mhz > new_mhz) ? old_mhz : new_mhz);
+
+    for (uint32_t i = 0u; i < CY_ARRAY_SIZE(cybsp_clock_profile_hf); i++)
+    {
+        on_pll[i] =
+            (CY_SYSCLK_CLKHF_IN_CLKPATH1 == Cy_SysClk_ClkHfGetSource(cybsp_clock_profile_hf[i]));
+        if (on_pll[i])
+        {
+            (void)Cy_SysClk_ClkHfSetSource(cybsp_clock_profile_hf[i], CY_SYSCLK_CLKHF_IN_CLKPATH0);
+        }
+    }
+
+    // Everything now runs from the IMO, so the dividers can be changed in any order without
+    // overclocking CLK_PERI or the other CLK_HF instances.
+    Cy_SysClk_ClkPeriSetDivider(profile->peri_div);
+    for (uint32_t i = 1u; i < CY_ARRAY_SIZE(cybsp_clock_profile_hf); i++)
+    {
+        (void)Cy_SysClk_ClkHfSetDivider(cybsp_clock_profile_hf[i], profile->hf_div[i]);
+    }
+    (void)Cy_SysClk_ClkHfSetDivider(0u, profile->hf_div[0]);
+
+    const cy_stc_pll_config_t pll_config =
+    {
+        .inputFreq  = Cy_SysClk_ClkPathMuxGetFrequency(CYBSP_CLOCK_PROFILE_PLL_PATH),
+        .outputFreq = profile->pll_hz,
+        .lfMode     = false,
+        .outputMode = CY_SYSCLK_FLLPLL_OUTPUT_AUTO
+    };
+
+    Cy_SysClk_PllDisable(CYBSP_CLOCK_PROFILE_PLL_PATH);
+    cy_en_sysclk_status_t status =
+        Cy_SysClk_PllConfigure(CYBSP_CLOCK_PROFILE_PLL_PATH, &pll_config);
+    SystemCoreClockUpdate();
+
+    Cy_SysLib_ExitCriticalSection(savedIntrStatus);
+
+    // Nothing is sourced from PLL0 while it locks
+    if (CY_SYSCLK_SUCCESS == status)
+    {
+        status = Cy_SysClk_PllEnable(CYBSP_CLOCK_PROFILE_PLL_PATH,
+                                     CYBSP_CLOCK_PROFILE_PLL_TIMEOUT_US);
+    }
+
+    savedIntrStatus = Cy_SysLib_EnterCriticalSection();
+
+    if (CY_SYSCLK_SUCCESS == status)
+    {
+        for (uint32_t i = 0u; i < CY_ARRAY_SIZE(cybsp_clock_profile_hf); i++)
+        {
+            if (on_pll[i])
+            {
+                (void)Cy_SysClk_ClkHfSetSource(cybsp_clock_profile_hf[i],
+                                               CY_SYSCLK_CLKHF_IN_CLKPATH1);
+            }
+        }
+        #if defined(CYBSP_POWER_STATS)
+        // Close the active time of the previous level
+        cybsp_power_stats_checkpoint();
+        #endif
+        cybsp_perf_level = level;
+    }
+    else
+    {
+        // Leave the clocks on the IMO; the system keeps running, only slower.
+        result = CYBSP_RSLT_ERR_CLOCK_PROFILE;
+    }
+
+    SystemCoreClockUpdate();
+    Cy_SysLib_SetWaitStates(ulp_mode, CY_SYSLIB_DIV_ROUNDUP(SystemCoreClock, 1000000UL));
+
+    Cy_SysLib_ExitCriticalSection(savedIntrStatus);
+
+    return result;
+}
+
+
+//--------------------------------------------------------------------------------------------------
+// cybsp_clock_profile_set_regulator
+//
+// Switches the core regulator between LP (1.1 V) and ULP (0.9 V) mode without running the
+// Cy_SysPm callbacks, which cybsp_set_performance_level() already executes around the whole
+// transition. The wait states must already suit the slower of the two modes.
+//--------------------------------------------------------------------------------------------------
+static void cybsp_clock_profile_set_regulator(bool ulp_mode)
+{
+    if (Cy_SysPm_LdoIsEnabled())
+    {
+        (void)Cy_SysPm_LdoSetVoltage(ulp_mode
+                                     ? CY_SYSPM_LDO_VOLTAGE_ULP
+                                     : CY_SYSPM_LDO_VOLTAGE_LP);
+    }
+    else
+    {
+        Cy_SysPm_BuckSetVoltage1(ulp_mode
+                                 ? CY_SYSPM_BUCK_OUT1_VOLTAGE_ULP
+                                 : CY_SYSPM_BUCK_OUT1_VOLTAGE_LP);
+    }
+}
+
+
+//--------------------------------------------------------------------------------------------------
+// cybsp_clock_profile_init
+//--------------------------------------------------------------------------------------------------
+cy_rslt_t cybsp_clock_profile_init(void)
+{
+    cy_rslt_t result = CY_RSLT_SUCCESS;
+
+    // design.modus already configures the nominal level
+    if (CYBSP_PERF_LEVEL_NOMINAL != CYBSP_CLOCK_PROFILE_BOOT_LEVEL)
+    {
+        // Anything faster than 50 MHz needs the LP (1.1 V) core regulator setting
+        result = Cy_SysPm_IsSystemUlp()
+            ? CYBSP_RSLT_ERR_CLOCK_PROFILE
+            : cybsp_clock_profile_apply(CYBSP_CLOCK_PROFILE_BOOT_LEVEL);
+    }
+    return result;
+}
+
+
+//--------------------------------------------------------------------------------------------------
+// cybsp_set_performance_level
+//--------------------------------------------------------------------------------------------------
+cy_rslt_t cybsp_set_performance_level(cybsp_perf_level_t level)
+{
+    if ((uint32_t)level >= CY_ARRAY_SIZE(cybsp_clock_profiles))
+    {
+        return CYBSP_RSLT_ERR_CLOCK_PROFILE;
+    }
+    if (level == cybsp_perf_level)
+    {
+        return CY_RSLT_SUCCESS;
+    }
+    #if (0 == CYBSP_CLOCK_PROFILE_RETIME_ALLOWED)
+    // The network processor keeps running on the nominal CLK_PERI/CLK_SLOW
+    if (CYBSP_PERF_LEVEL_NOMINAL != level)
+    {
+        return CYBSP_RSLT_ERR_PERF_LEVEL_NP;
+    }
+    #endif
+
+    cy_rslt_t                   result  = CY_RSLT_SUCCESS;
+    bool                        to_ulp  = (CYBSP_PERF_LEVEL_LOW == level);
+    cy_en_syspm_callback_type_t cb_type = to_ulp ? CY_SYSPM_ULP : CY_SYSPM_LP;
+
+    if (CY_SYSPM_SUCCESS != Cy_SysPm_ExecuteCallback(cb_type, CY_SYSPM_CHECK_READY))
+    {
+        (void)Cy_SysPm_ExecuteCallback(cb_type, CY_SYSPM_CHECK_FAIL);
+        return CYBSP_RSLT_ERR_PERF_LEVEL_REJECTED;
+    }
+    (void)Cy_SysPm_ExecuteCallback(cb_type, CY_SYSPM_BEFORE_TRANSITION);
+
+    cybsp_perf_level_t from = cybsp_perf_level;
+    cybsp_clock_profile_notify(CYBSP_CLOCK_CHANGE_BEFORE, from, level);
+
+    // Leaving ULP: raise the core voltage before the clocks go faster than 50 MHz
+    if (!to_ulp && Cy_SysPm_IsSystemUlp())
+    {
+        cybsp_clock_profile_set_regulator(false);
+    }
+
+    result = cybsp_clock_profile_apply(level);
+
+    // Entering ULP: lower the core voltage once the clocks are within the ULP limits
+    if (to_ulp && (CY_RSLT_SUCCESS == result))
+    {
+        Cy_SysLib_SetWaitStates(true, CY_SYSLIB_DIV_ROUNDUP(SystemCoreClock, 1000000UL));
+        cybsp_clock_profile_set_regulator(true);
+    }
+
+    cybsp_clock_profile_notify(CYBSP_CLOCK_CHANGE_AFTER, from, level);
+    (void)Cy_SysPm_ExecuteCallback(cb_type, CY_SYSPM_AFTER_TRANSITION);
+
+    return result;
+}
+
+
+//--------------------------------------------------------------------------------------------------
+// cybsp_register_clock_change_handler
+//--------------------------------------------------------------------------------------------------
+cy_rslt_t cybsp_register_clock_change_handler(cybsp_clock_change_handler_t* handler)
+{
+    if ((NULL == handler) || (NULL == handler->callback))
+    {
+        return CYBSP_RSLT_ERR_CLOCK_PROFILE;
+    }
+
+    cybsp_clock_change_handler_t** link = &cybsp_clock_change_handlers;
+    while ((NULL != *link) && (handler != *link))
+    {
+        link = &(*link)->next;
+    }
+    if (NULL == *link)
+    {
+        handler->next = NULL;
+        *link         = handler;
+    }
+    return CY_RSLT_SUCCESS;
+}
+
+
+//--------------------------------------------------------------------------------------------------
+// cybsp_unregister_clock_change_handler
+//--------------------------------------------------------------------------------------------------
+void cybsp_unregister_clock_change_handler(cybsp_clock_change_handler_t* handler)
+{
+    cybsp_clock_change_handler_t** link = &cybsp_clock_change_handlers;
+    while ((NULL != *link) && (handler != *link))
+    {
+        link = &(*link)->next;
+    }
+    if (NULL != *link)
+    {
+        *link = handler->next;
+    }
+}
+
+
+//--------------------------------------------------------------------------------------------------
+// cybsp_get_performance_level
+//--------------------------------------------------------------------------------------------------
+cybsp_perf_level_t cybsp_get_performance_level(void)
+{
+    return cybsp_perf_level;
+}
+
+
+#if defined(__cplusplus)
+}
+#endif
@@ -0,0 +1,170 @@
+/***********************************************************************************************//**
+ * \file cybsp_clock_profile.h
+ *
+ * \brief
+ * Selectable clock profiles (operating points) for the CM4 clock tree.
+ *
+ ***************************************************************************************************
+ * \copyright
+ * Copyright 2023 Cypress Semiconductor Corporation (an Infineon company) or
+ * an affiliate of Cypress Semiconductor Corporation
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ **************************************************************************************************/
+
+#pragma once
+
+#include <stdint.h>
+#include "cy_result.h"
+
+#if defined(__cplusplus)
+extern "C" {
+#endif
+
+/**
+ * \addtogroup group_bsp_clock_profile Clock Profiles
+ * \{
+ * The Device Configurator (design.modus) sets up PLL0 (clock path 1) at 100 MHz and sources
+ * CLK_HF0, CLK_HF2 and CLK_HF4 from it. This is the nominal performance level. The BSP can move
+ * the clock tree to a different performance level by reprogramming PLL0 and the dividers behind
+ * it, so no alternate design.modus is needed.
+ *
+ * Defining CYBSP_CLOCK_PROFILE_PERFORMANCE makes \ref cybsp_init switch to
+ * \ref CYBSP_PERF_LEVEL_HIGH right after the generated configuration has been applied. At runtime
+ * \ref cybsp_set_performance_level moves between all levels, including the core regulator
+ * change between LP (1.1 V) and ULP (0.9 V) mode.
+ *
+ * | Level                        | Regulator | PLL0 / CLK_HF0 | CLK_PERI | CLK_HF2 | CLK_HF4 |
+ * | :--------------------------- | :-------- | :------------- | :------- | :------ | :------ |
+ * | \ref CYBSP_PERF_LEVEL_LOW     | ULP       | 50 MHz         | 25 MHz   | 25 MHz  | 50 MHz  |
+ * | \ref CYBSP_PERF_LEVEL_NOMINAL | LP        | 100 MHz        | 100 MHz  | 50 MHz  | 100 MHz |
+ * | \ref CYBSP_PERF_LEVEL_HIGH    | LP        | 150 MHz        | 75 MHz   | 75 MHz  | 75 MHz  |
+ *
+ * CLK_PERI (and CLK_SLOW, which clocks the CM0+) is limited to 100 MHz in LP mode and to 25 MHz
+ * in ULP mode. It is divided from CLK_HF0 by an integer, so it cannot stay at 100 MHz at the low
+ * and high levels. A level change therefore retimes everything behind the changed clocks:
+ * - CLK_PERI and CLK_SLOW: all peripheral clock dividers configured in design.modus (SCB UARTs
+ *   including the debug UART and the Bluetooth HCI UART, TCPWM timers) and the CM0+.
+ *   A network processor image on the CM0+ cannot be notified and uses the reserved dividers
+ *   div_16[0]/[1], so levels other than \ref CYBSP_PERF_LEVEL_NOMINAL are only available when
+ *   the CM0+ runs the CM0P_SLEEP image and the SCL component is not used. Otherwise
+ *   CYBSP_CLOCK_PROFILE_PERFORMANCE fails to build and \ref cybsp_set_performance_level only
+ *   accepts the nominal level.
+ * - CLK_HF2: the SMIF (QSPI flash) interface.
+ * - CLK_HF4: the SDHC interface to the CYW43012 Wi-Fi.
+ *
+ * Drivers that derive a baud rate or bit timing from these clocks must be reconfigured. Besides
+ * the Cy_SysPm callbacks, \ref cybsp_register_clock_change_handler registers a handler that is
+ * told the old and new level right before and right after the clocks change.
+ *
+ * While PLL0 locks during a level change, the system runs from the 8 MHz IMO with interrupts
+ * enabled.
+ */
+
+/** Predefined clock tree operating points */
+typedef enum
+{
+    CYBSP_PERF_LEVEL_LOW,       /**< 50 MHz CLK_HF0 in ULP mode, minimum active power */
+    CYBSP_PERF_LEVEL_NOMINAL,   /**< 100 MHz CLK_HF0, the design.modus configuration */
+    CYBSP_PERF_LEVEL_HIGH,      /**< 150 MHz CLK_HF0, maximum CM4 throughput */
+    CYBSP_PERF_LEVEL_COUNT      /**< Number of levels, not a valid level */
+} cybsp_perf_level_t;
+
+/** Point of a performance level change at which a clock change handler is called */
+typedef enum
+{
+    CYBSP_CLOCK_CHANGE_BEFORE,  /**< Clocks still run at the old level */
+    CYBSP_CLOCK_CHANGE_AFTER    /**< Clocks, SystemCoreClock and the regulator are updated */
+} cybsp_clock_change_event_t;
+
+/**
+ * Called by \ref cybsp_set_performance_level around a level change, with interrupts enabled.
+ * On a failed change the \ref CYBSP_CLOCK_CHANGE_AFTER call is still made; the clocks then run
+ * from the IMO and \ref cybsp_get_performance_level still returns \p from.
+ */
+typedef void (* cybsp_clock_change_callback_t)(cybsp_clock_change_event_t event,
+                                               cybsp_perf_level_t from, cybsp_perf_level_t to,
+                                               void* arg);
+
+/** Clock change handler, allocated by the application and linked in by the BSP */
+typedef struct cybsp_clock_change_handler
+{
+    cybsp_clock_change_callback_t       callback;   /**< Function to call, must not be NULL */
+    void*                               arg;        /**< Argument passed to the callback */
+    struct cybsp_clock_change_handler*  next;       /**< Managed by the BSP */
+} cybsp_clock_change_handler_t;
+
+/**
+ * \brief Applies the clock profile selected at build time.
+ * Called by \ref cybsp_init after the generated configuration has been applied. Does nothing
+ * unless CYBSP_CLOCK_PROFILE_PERFORMANCE is defined.
+ * \returns CY_RSLT_SUCCESS if the profile was applied, otherwise an error
+ */
+cy_rslt_t cybsp_clock_profile_init(void);
+
+/**
+ * \brief Moves the clock tree and core regulator to a different performance level at runtime.
+ *
+ * Registered Cy_SysPm callbacks and the handlers registered with
+ * \ref cybsp_register_clock_change_handler are notified so drivers can recompute their dividers.
+ * Callbacks of type CY_SYSPM_ULP are notified when moving to \ref CYBSP_PERF_LEVEL_LOW and
+ * callbacks of type CY_SYSPM_LP for every other move (including between the nominal and high
+ * levels). They receive CY_SYSPM_CHECK_READY, then CY_SYSPM_BEFORE_TRANSITION and
+ * CY_SYSPM_AFTER_TRANSITION once both the regulator and the clocks have their final settings. If a
+ * callback fails the check, all checked callbacks receive CY_SYSPM_CHECK_FAIL and nothing is
+ * changed. The clock change handlers are called with \ref CYBSP_CLOCK_CHANGE_BEFORE after
+ * CY_SYSPM_BEFORE_TRANSITION and with \ref CYBSP_CLOCK_CHANGE_AFTER before
+ * CY_SYSPM_AFTER_TRANSITION.
+ *
+ * SystemCoreClock, cy_delayFreqMhz, cy_delayFreqKhz and cy_AhbFreqHz are updated before the
+ * CY_SYSPM_AFTER_TRANSITION notification. The function is not reentrant and must not be called
+ * from an interrupt.
+ *
+ * \param level The performance level to move to
+ * \returns CY_RSLT_SUCCESS if the level was applied, CYBSP_RSLT_ERR_PERF_LEVEL_NP if the level
+ *          is not \ref CYBSP_PERF_LEVEL_NOMINAL and the CM0+ does not run the CM0P_SLEEP image
+ *          (or the SCL component is used), CYBSP_RSLT_ERR_PERF_LEVEL_REJECTED if a callback
+ *          rejected the transition or CYBSP_RSLT_ERR_CLOCK_PROFILE if the clocks could not be
+ *          reconfigured.
+ */
+cy_rslt_t cybsp_set_performance_level(cybsp_perf_level_t level);
+
+/**
+ * \brief Registers a handler that is called before and after every performance level change.
+ * The handler must stay valid until it is unregistered. Handlers are called in registration
+ * order. Registering a handler that is already registered has no effect.
+ * \param handler The handler to register
+ * \returns CY_RSLT_SUCCESS if the handler was registered, CYBSP_RSLT_ERR_CLOCK_PROFILE if the
+ *          handler or its callback is NULL
+ */
+cy_rslt_t cybsp_register_clock_change_handler(cybsp_clock_change_handler_t* handler);
+
+/**
+ * \brief Unregisters a handler registered with \ref cybsp_register_clock_change_handler.
+ * \param handler The handler to remove, ignored if it is not registered
+ */
+void cybsp_unregister_clock_change_handler(cybsp_clock_change_handler_t* handler);
+
+/**
+ * \brief Returns the current performance level.
+ * \returns The performance level the clock tree is currently configured for
+ */
+cybsp_perf_level_t cybsp_get_performance_level(void);
+
+/** \} group_bsp_clock_profile */
+
+#ifdef __cplusplus
+}
+#endif // __cplusplus
@@ -0,0 +1,104 @@
+/***********************************************************************************************//**
+ * \file cybsp_lptimer.c
+ *
+ * Description:
+ * LPTIMER shared by the BSP features that need a time base running in Deep Sleep.
+ *
+ ***************************************************************************************************
+ * \copyright
+ * Copyright 2023 Cypress Semiconductor Corporation (an Infineon company) or
+ * an affiliate of Cypress Semiconductor Corporation
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ **************************************************************************************************/
+
+#include "cybsp_lptimer.h"
+
+#if defined(CYBSP_LPTIMER_SHARED)
+
+#include <stdbool.h>
+#include <stddef.h>
+#include "cy_syslib.h"
+
+#if defined(__cplusplus)
+extern "C" {
+#endif
+
+static cyhal_lptimer_t     cybsp_lptimer_obj;
+static volatile bool       cybsp_lptimer_ready = false;
+static uint32_t            cybsp_lptimer_hz;
+
+//--------------------------------------------------------------------------------------------------
+// cybsp_lptimer_init
+//--------------------------------------------------------------------------------------------------
+cy_rslt_t cybsp_lptimer_init(void)
+{
+    cy_rslt_t result = CY_RSLT_SUCCESS;
+    if (cybsp_lptimer_ready)
+    {
+        return result;
+    }
+
+    // The features reserve the timer from cybsp_init(), their init functions or the idle task,
+    // so a reservation must not interleave with another one
+    uint32_t savedIntrStatus = Cy_SysLib_EnterCriticalSection();
+    if (!cybsp_lptimer_ready)
+    {
+        result = cyhal_lptimer_init(&cybsp_lptimer_obj);
+        if (CY_RSLT_SUCCESS == result)
+        {
+            cyhal_lptimer_info_t info;
+            cyhal_lptimer_get_info(&cybsp_lptimer_obj, &info);
+            cybsp_lptimer_hz    = info.frequency_hz;
+            cybsp_lptimer_ready = true;
+        }
+    }
+    Cy_SysLib_ExitCriticalSection(savedIntrStatus);
+    return result;
+}
+
+
+//--------------------------------------------------------------------------------------------------
+// cybsp_lptimer_get
+//--------------------------------------------------------------------------------------------------
+cyhal_lptimer_t* cybsp_lptimer_get(void)
+{
+    return cybsp_lptimer_ready ? &cybsp_lptimer_obj : NULL;
+}
+
+
+//--------------------------------------------------------------------------------------------------
+// cybsp_lptimer_read
+//--------------------------------------------------------------------------------------------------
+uint32_t cybsp_lptimer_read(void)
+{
+    return cybsp_lptimer_ready ? cyhal_lptimer_read(&cybsp_lptimer_obj) : 0u;
+}
+
+
+//--------------------------------------------------------------------------------------------------
+// cybsp_lptimer_get_frequency
+//--------------------------------------------------------------------------------------------------
+uint32_t cybsp_lptimer_get_frequency(void)
+{
+    return cybsp_lptimer_ready ? cybsp_lptimer_hz : 0u;
+}
+
+
+#if defined(__cplusplus)
+}
+#endif
+
+#endif // defined(CYBSP_LPTIMER_SHARED)
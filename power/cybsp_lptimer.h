@@ -0,0 +1,87 @@
+/***********************************************************************************************//**
+ * \file cybsp_lptimer.h
+ *
+ * \brief
+ * LPTIMER shared by the BSP features that need a time base running in Deep Sleep.
+ *
+ ***************************************************************************************************
+ * \copyright
+ * Copyright 2023 Cypress Semiconductor Corporation (an Infineon company) or
+ * an affiliate of Cypress Semiconductor Corporation
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ **************************************************************************************************/
+
+#pragma once
+
+#include <stdint.h>
+#include "cy_result.h"
+
+#if defined(CYBSP_POWER_STATS) || defined(CYBSP_CPU_LOAD) || defined(CYBSP_TICKLESS_IDLE)
+/** \cond INTERNAL */
+#define CYBSP_LPTIMER_SHARED
+/** \endcond */
+#include "cyhal_lptimer.h"
+#endif
+
+#if defined(__cplusplus)
+extern "C" {
+#endif
+
+/**
+ * \addtogroup group_bsp_lptimer Shared LPTIMER
+ * \{
+ * The device has two MCWDTs, and the HAL LPTIMER uses one of them, so the BSP reserves a single
+ * LPTIMER for all of its features and leaves the other MCWDT to the application. Power accounting
+ * (CYBSP_POWER_STATS) and the CPU load (CYBSP_CPU_LOAD) only read its free-running count. FreeRTOS
+ * tickless idle (CYBSP_TICKLESS_IDLE) also programs its match events, which does not reset the
+ * count, so the readers are not disturbed.
+ *
+ * The timer is reserved by the first feature that needs it and is never freed.
+ */
+
+#if defined(CYBSP_LPTIMER_SHARED)
+
+/**
+ * \brief Reserves the shared LPTIMER if it is not reserved yet.
+ * \returns CY_RSLT_SUCCESS, or the error from cyhal_lptimer_init() if no LPTIMER is free
+ */
+cy_rslt_t cybsp_lptimer_init(void);
+
+/**
+ * \brief Returns the shared LPTIMER.
+ * \returns The timer object, NULL before a successful \ref cybsp_lptimer_init
+ */
+cyhal_lptimer_t* cybsp_lptimer_get(void);
+
+/**
+ * \brief Returns the free-running count of the shared LPTIMER.
+ * \returns The count, 0 before a successful \ref cybsp_lptimer_init
+ */
+uint32_t cybsp_lptimer_read(void);
+
+/**
+ * \brief Returns the tick rate of the shared LPTIMER, the LFCLK frequency reported by the HAL.
+ * \returns The frequency in Hz, 0 before a successful \ref cybsp_lptimer_init
+ */
+uint32_t cybsp_lptimer_get_frequency(void);
+
+#endif // defined(CYBSP_LPTIMER_SHARED)
+
+/** \} group_bsp_lptimer */
+
+#ifdef __cplusplus
+}
+#endif // __cplusplus
@@ -0,0 +1,410 @@
+/***********************************************************************************************//**
+ * \file cybsp_pm_latency.c
+ *
+ * Description:
+ * Measures the latency of the deep sleep callback chain and implements the fast wakeup option.
+ *
+ ***************************************************************************************************
+ * \copyright
+ * Copyright 2023 Cypress Semiconductor Corporation (an Infineon company) or
+ * an affiliate of Cypress Semiconductor Corporation
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ **************************************************************************************************/
+
+#if defined(CYBSP_PM_LATENCY) || defined(CYBSP_PM_FAST_WAKE)
+
+#include <stddef.h>
+#include "cy_device_headers.h"
+#include "cy_syslib.h"
+#include "cy_sysclk.h"
+#include "system_psoc6.h"
+#include "cybsp.h"
+
+#if defined(__cplusplus)
+extern "C" {
+#endif
+
+#if defined(CYBSP_PM_LATENCY)
+
+typedef struct
+{
+    cybsp_pm_latency_probe_t*   probes;
+    cybsp_pm_latency_report_t   report;
+    bool                        waking;         // Between the first and last AFTER_TRANSITION
+    uint32_t                    entry_start;    // First CHECK_READY
+    uint32_t                    entry_end;      // End of the last BEFORE_TRANSITION
+    uint32_t                    entry_clock_hz; // SystemCoreClock during the entry
+    uint32_t                    exit_start;     // Start of the first AFTER_TRANSITION
+    uint32_t                    exit_imo_cycles;
+} cybsp_pm_latency_t;
+
+static cybsp_pm_latency_t cybsp_pm_latency;
+
+//--------------------------------------------------------------------------------------------------
+// cybsp_pm_latency_to_us
+//--------------------------------------------------------------------------------------------------
+static uint32_t cybsp_pm_latency_to_us(uint32_t cycles, uint32_t clock_hz)
+{
+    uint32_t mhz = CY_SYSLIB_DIV_ROUNDUP(clock_hz, 1000000UL);
+    return (0u != mhz) ? (cycles / mhz) : 0u;
+}
+
+
+//--------------------------------------------------------------------------------------------------
+// cybsp_pm_latency_probe_callback
+//
+// Installed in place of every wrapped callback. The parameter structure is the first member of the
+// probe, so the probe is recovered from the pointer the PDL passes in.
+//--------------------------------------------------------------------------------------------------
+static cy_en_syspm_status_t cybsp_pm_latency_probe_callback(cy_stc_syspm_callback_params_t* params,
+                                                            cy_en_syspm_callback_mode_t mode)
+{
+    cybsp_pm_latency_probe_t* probe = (cybsp_pm_latency_probe_t*)params;
+    uint32_t                  start = DWT->CYCCNT;
+
+    if ((CY_SYSPM_AFTER_TRANSITION == mode) && !cybsp_pm_latency.waking)
+    {
+        // First callback executed after wakeup
+        cybsp_pm_latency.waking          = true;
+        cybsp_pm_latency.exit_start      = start;
+        cybsp_pm_latency.exit_imo_cycles = 0u;
+    }
+
+    cy_en_syspm_status_t status = probe->callback(&probe->params, mode);
+    uint32_t             cycles = DWT->CYCCNT - start;
+
+    switch (mode)
+    {
+        case CY_SYSPM_CHECK_READY:
+            probe->entry_cycles = cycles;
+            break;
+
+        case CY_SYSPM_BEFORE_TRANSITION:
+            probe->entry_cycles += cycles;
+            if (probe->entry_cycles > probe->max_entry_cycles)
+            {
+                probe->max_entry_cycles = probe->entry_cycles;
+            }
+            cybsp_pm_latency.entry_end = start + cycles;
+            break;
+
+        case CY_SYSPM_AFTER_TRANSITION:
+            probe->exit_cycles = cycles;
+            if (cycles > probe->max_exit_cycles)
+            {
+                probe->max_exit_cycles = cycles;
+            }
+            if (probe->runs_from_imo)
+            {
+                cybsp_pm_latency.exit_imo_cycles += cycles;
+            }
+            break;
+
+        default:
+            break;
+    }
+
+    return status;
+}
+
+
+//--------------------------------------------------------------------------------------------------
+// cybsp_pm_latency_boundary_callback
+//
+// Registered with order 0: first on CHECK_READY/BEFORE_TRANSITION and last on AFTER_TRANSITION.
+//--------------------------------------------------------------------------------------------------
+static cy_en_syspm_status_t cybsp_pm_latency_boundary_callback(
+    cy_stc_syspm_callback_params_t* params, cy_en_syspm_callback_mode_t mode)
+{
+    CY_UNUSED_PARAMETER(params);
+    uint32_t now = DWT->CYCCNT;
+
+    if (CY_SYSPM_CHECK_READY == mode)
+    {
+        cybsp_pm_latency.entry_start    = now;
+        cybsp_pm_latency.entry_end      = now;
+        cybsp_pm_latency.entry_clock_hz = SystemCoreClock;
+    }
+    else if ((CY_SYSPM_AFTER_TRANSITION == mode) && cybsp_pm_latency.waking)
+    {
+        cybsp_pm_latency_report_t* report = &cybsp_pm_latency.report;
+        uint32_t exit_cycles = now - cybsp_pm_latency.exit_start;
+        uint32_t imo_cycles  = cybsp_pm_latency.exit_imo_cycles;
+
+        // The entry ran at the pre-sleep core clock, the exit partly (or, with CYBSP_PM_FAST_WAKE,
+        // entirely) from the IMO, which SystemCoreClock reflects by now
+        report->entry_us = cybsp_pm_latency_to_us(
+            cybsp_pm_latency.entry_end - cybsp_pm_latency.entry_start,
+            cybsp_pm_latency.entry_clock_hz);
+        report->clock_restore_us = cybsp_pm_latency_to_us(imo_cycles, CY_SYSCLK_IMO_FREQ);
+        report->exit_us          = report->clock_restore_us +
+                                   cybsp_pm_latency_to_us(exit_cycles - imo_cycles,
+                                                          SystemCoreClock);
+
+        if (report->entry_us > report->max_entry_us)
+        {
+            report->max_entry_us = report->entry_us;
+        }
+        if (report->exit_us > report->max_exit_us)
+        {
+            report->max_exit_us = report->exit_us;
+        }
+        if (report->clock_restore_us > report->max_clock_restore_us)
+        {
+            report->max_clock_restore_us = report->clock_restore_us;
+        }
+        report->transitions++;
+        cybsp_pm_latency.waking = false;
+    }
+
+    return CY_SYSPM_SUCCESS;
+}
+
+
+//--------------------------------------------------------------------------------------------------
+// cybsp_pm_latency_init
+//--------------------------------------------------------------------------------------------------
+cy_rslt_t cybsp_pm_latency_init(void)
+{
+    static cy_stc_syspm_callback_params_t cybsp_pm_latency_boundary_param = { NULL, NULL };
+    static cy_stc_syspm_callback_t        cybsp_pm_latency_boundary        =
+    {
+        .callback       = &cybsp_pm_latency_boundary_callback,
+        .type           = CY_SYSPM_DEEPSLEEP,
+        .callbackParams = &cybsp_pm_latency_boundary_param,
+        .order          = 0u
+    };
+
+    CoreDebug->DEMCR |= CoreDebug_DEMCR_TRCENA_Msk;
+    DWT->CTRL        |= DWT_CTRL_CYCCNTENA_Msk;
+
+    return Cy_SysPm_RegisterCallback(&cybsp_pm_latency_boundary)
+        ? CY_RSLT_SUCCESS
+        : CYBSP_RSLT_ERR_PM_LATENCY_CALLBACK;
+}
+
+
+//--------------------------------------------------------------------------------------------------
+// cybsp_pm_latency_wrap
+//--------------------------------------------------------------------------------------------------
+cy_rslt_t cybsp_pm_latency_wrap(cybsp_pm_latency_probe_t* probe,
+                                cy_stc_syspm_callback_t* callback, const char* name)
+{
+    if ((NULL == probe) || (NULL == callback) || (NULL == callback->callback))
+    {
+        return CYBSP_RSLT_ERR_PM_LATENCY_BAD_ARG;
+    }
+
+    probe->params.base       = (NULL != callback->callbackParams)
+        ? callback->callbackParams->base
+        : NULL;
+    probe->params.context    = (NULL != callback->callbackParams)
+        ? callback->callbackParams->context
+        : NULL;
+    probe->callback          = callback->callback;
+    probe->name              = name;
+    probe->entry_cycles      = 0u;
+    probe->exit_cycles       = 0u;
+    probe->max_entry_cycles  = 0u;
+    probe->max_exit_cycles   = 0u;
+
+    callback->callback       = &cybsp_pm_latency_probe_callback;
+    callback->callbackParams = &probe->params;
+
+    uint32_t savedIntrStatus = Cy_SysLib_EnterCriticalSection();
+    probe->next             = cybsp_pm_latency.probes;
+    cybsp_pm_latency.probes = probe;
+    Cy_SysLib_ExitCriticalSection(savedIntrStatus);
+
+    return CY_RSLT_SUCCESS;
+}
+
+
+//--------------------------------------------------------------------------------------------------
+// cybsp_pm_latency_get_report
+//--------------------------------------------------------------------------------------------------
+void cybsp_pm_latency_get_report(cybsp_pm_latency_report_t* report)
+{
+    CY_ASSERT(NULL != report);
+
+    uint32_t savedIntrStatus = Cy_SysLib_EnterCriticalSection();
+    *report = cybsp_pm_latency.report;
+    Cy_SysLib_ExitCriticalSection(savedIntrStatus);
+}
+
+
+//--------------------------------------------------------------------------------------------------
+// cybsp_pm_latency_get_probes
+//--------------------------------------------------------------------------------------------------
+const cybsp_pm_latency_probe_t* cybsp_pm_latency_get_probes(void)
+{
+    return cybsp_pm_latency.probes;
+}
+
+
+//--------------------------------------------------------------------------------------------------
+// cybsp_pm_latency_reset
+//--------------------------------------------------------------------------------------------------
+void cybsp_pm_latency_reset(void)
+{
+    uint32_t savedIntrStatus = Cy_SysLib_EnterCriticalSection();
+    cybsp_pm_latency.report = (cybsp_pm_latency_report_t) { 0u };
+    for (cybsp_pm_latency_probe_t* probe = cybsp_pm_latency.probes; NULL != probe;
+         probe = probe->next)
+    {
+        probe->max_entry_cycles = 0u;
+        probe->max_exit_cycles  = 0u;
+    }
+    Cy_SysLib_ExitCriticalSection(savedIntrStatus);
+}
+
+
+//--------------------------------------------------------------------------------------------------
+// cybsp_pm_latency_dump
+//--------------------------------------------------------------------------------------------------
+void cybsp_pm_latency_dump(cybsp_pm_latency_print_t print_fn)
+{
+    if (NULL != print_fn)
+    {
+        cybsp_pm_latency_report_t report;
+        cybsp_pm_latency_get_report(&report);
+
+        (void)print_fn("deep sleep transitions %lu\r\n", (unsigned long)report.transitions);
+        (void)print_fn("entry          %8lu us  (max %8lu us)\r\n",
+                       (unsigned long)report.entry_us, (unsigned long)report.max_entry_us);
+        (void)print_fn("wake-to-run    %8lu us  (max %8lu us)\r\n",
+                       (unsigned long)report.exit_us, (unsigned long)report.max_exit_us);
+        (void)print_fn("clock restore  %8lu us  (max %8lu us)\r\n",
+                       (unsigned long)report.clock_restore_us,
+                       (unsigned long)report.max_clock_restore_us);
+        #if defined(CYBSP_PM_FAST_WAKE)
+        (void)print_fn("PLL switch-back %7lu us\r\n", (unsigned long)report.pll_relock_us);
+        #endif
+
+        for (const cybsp_pm_latency_probe_t* probe = cybsp_pm_latency.probes; NULL != probe;
+             probe = probe->next)
+        {
+            (void)print_fn("%-16s entry %10lu cyc (max %10lu)  exit %10lu cyc (max %10lu)\r\n",
+                           (NULL != probe->name) ? probe->name : "?",
+                           (unsigned long)probe->entry_cycles,
+                           (unsigned long)probe->max_entry_cycles,
+                           (unsigned long)probe->exit_cycles,
+                           (unsigned long)probe->max_exit_cycles);
+        }
+    }
+}
+
+
+#endif // defined(CYBSP_PM_LATENCY)
+
+#if defined(CYBSP_PM_FAST_WAKE)
+
+// Clock path driven by PLL0 in design.modus, and the CLK_HF instances it feeds
+#define CYBSP_PM_FAST_WAKE_PLL_PATH         (1u)
+#ifndef CYBSP_PM_FAST_WAKE_PLL_TIMEOUT_US
+    #define CYBSP_PM_FAST_WAKE_PLL_TIMEOUT_US   (10000u)
+#endif
+
+static const uint32_t cybsp_pm_fast_wake_hf[] = { 0u, 2u, 4u };
+
+// Bit n set: cybsp_pm_fast_wake_hf[n] was moved off the PLL and must be switched back
+static volatile uint32_t cybsp_pm_fast_wake_pending = 0u;
+#if defined(CYBSP_PM_LATENCY)
+static uint32_t cybsp_pm_fast_wake_start;
+#endif
+
+//--------------------------------------------------------------------------------------------------
+// cybsp_pm_fast_wake_callback
+//--------------------------------------------------------------------------------------------------
+cy_en_syspm_status_t cybsp_pm_fast_wake_callback(cy_stc_syspm_callback_params_t* params,
+                                                 cy_en_syspm_callback_mode_t mode)
+{
+    if (CY_SYSPM_BEFORE_TRANSITION == mode)
+    {
+        // Park everything fed by the PLL on clock path 0, which runs from the IMO because the FLL
+        // is not used. Cy_SysClk_DeepSleepCallback() then has no PLL to wait for on wakeup.
+        for (uint32_t i = 0u; i < CY_ARRAY_SIZE(cybsp_pm_fast_wake_hf); i++)
+        {
+            if (CY_SYSCLK_CLKHF_IN_CLKPATH1 == Cy_SysClk_ClkHfGetSource(cybsp_pm_fast_wake_hf[i]))
+            {
+                (void)Cy_SysClk_ClkHfSetSource(cybsp_pm_fast_wake_hf[i],
+                                               CY_SYSCLK_CLKHF_IN_CLKPATH0);
+                cybsp_pm_fast_wake_pending |= (1UL << i);
+            }
+        }
+    }
+
+    cy_en_syspm_status_t status = Cy_SysClk_DeepSleepCallback(params, mode);
+
+    if ((CY_SYSPM_AFTER_TRANSITION == mode) && (0u != cybsp_pm_fast_wake_pending))
+    {
+        // Keep running from the IMO; the PLL relocks in the background
+        SystemCoreClockUpdate();
+        #if defined(CYBSP_PM_LATENCY)
+        cybsp_pm_fast_wake_start = DWT->CYCCNT;
+        #endif
+    }
+
+    return status;
+}
+
+
+//--------------------------------------------------------------------------------------------------
+// cybsp_pm_fast_wake_process
+//--------------------------------------------------------------------------------------------------
+bool cybsp_pm_fast_wake_process(void)
+{
+    if (0u == cybsp_pm_fast_wake_pending)
+    {
+        return true;
+    }
+    if (!Cy_SysClk_PllLocked(CYBSP_PM_FAST_WAKE_PLL_PATH))
+    {
+        return false;
+    }
+
+    uint32_t savedIntrStatus = Cy_SysLib_EnterCriticalSection();
+
+    // Already locked, so this only makes sure the PLL output (not its bypass) is selected
+    (void)Cy_SysClk_PllEnable(CYBSP_PM_FAST_WAKE_PLL_PATH, CYBSP_PM_FAST_WAKE_PLL_TIMEOUT_US);
+    for (uint32_t i = 0u; i < CY_ARRAY_SIZE(cybsp_pm_fast_wake_hf); i++)
+    {
+        if (0u != (cybsp_pm_fast_wake_pending & (1UL << i)))
+        {
+            (void)Cy_SysClk_ClkHfSetSource(cybsp_pm_fast_wake_hf[i], CY_SYSCLK_CLKHF_IN_CLKPATH1);
+        }
+    }
+    cybsp_pm_fast_wake_pending = 0u;
+    SystemCoreClockUpdate();
+
+    #if defined(CYBSP_PM_LATENCY)
+    cybsp_pm_latency.report.pll_relock_us =
+        cybsp_pm_latency_to_us(DWT->CYCCNT - cybsp_pm_fast_wake_start, CY_SYSCLK_IMO_FREQ);
+    #endif
+
+    Cy_SysLib_ExitCriticalSection(savedIntrStatus);
+
+    return true;
+}
+
+
+#endif // defined(CYBSP_PM_FAST_WAKE)
+
+#if defined(__cplusplus)
+}
+#endif
+
+#endif // defined(CYBSP_PM_LATENCY) || defined(CYBSP_PM_FAST_WAKE)
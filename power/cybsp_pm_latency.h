@@ -0,0 +1,167 @@
+/***********************************************************************************************//**
+ * \file cybsp_pm_latency.h
+ *
+ * \brief
+ * Optional measurement of the deep sleep entry/exit latency and fast wakeup from deep sleep.
+ *
+ ***************************************************************************************************
+ * \copyright
+ * Copyright 2023 Cypress Semiconductor Corporation (an Infineon company) or
+ * an affiliate of Cypress Semiconductor Corporation
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ **************************************************************************************************/
+
+#pragma once
+
+#include <stdbool.h>
+#include <stdint.h>
+#include "cy_result.h"
+#include "cy_syspm.h"
+
+#if defined(__cplusplus)
+extern "C" {
+#endif
+
+/**
+ * \addtogroup group_bsp_pm_latency Deep Sleep Latency
+ * \{
+ * When CYBSP_PM_LATENCY is defined, \ref cybsp_init wraps the SysClk deep sleep callback in a
+ * latency probe and registers a boundary callback with order 0, which runs first on entry and
+ * last on exit. Together they measure, with the DWT cycle counter:
+ * - the entry latency, from the first CY_SYSPM_CHECK_READY callback to the end of the last
+ *   CY_SYSPM_BEFORE_TRANSITION callback (right before the CPU executes WFI)
+ * - the exit latency, from the first CY_SYSPM_AFTER_TRANSITION callback after wakeup to the end of
+ *   the last one, i.e. until the application resumes
+ * - the clock restore time, the part of the exit spent in the SysClk callback waiting for the PLL
+ *   to relock and switching CLK_HF0 back to it. The WCO keeps running in deep sleep and the ECO is
+ *   not used on this board, so the PLL relock is the only clock settling time on wakeup.
+ *
+ * The time from the wakeup event to the first instruction executed (regulator and IMO startup) is
+ * not visible to software and is not included. Application callbacks can be measured individually
+ * by wrapping them with \ref cybsp_pm_latency_wrap before registering them.
+ *
+ * When CYBSP_PM_FAST_WAKE is defined, the SysClk callback is replaced by
+ * \ref cybsp_pm_fast_wake_callback. Before deep sleep it moves the clocks fed by the PLL to the
+ * IMO, so on wakeup the system resumes immediately at 8 MHz while the PLL relocks in the
+ * background. \ref cybsp_pm_fast_wake_process switches back to the PLL once it has locked.
+ */
+
+#if defined(CYBSP_PM_LATENCY)
+
+/** Latency probe around a single power management callback */
+typedef struct cybsp_pm_latency_probe
+{
+    cy_stc_syspm_callback_params_t  params;             /**< Parameters passed on to the wrapped
+                                                             callback. Must be the first member. */
+    Cy_SysPmCallback                callback;           /**< Wrapped callback */
+    const char*                     name;               /**< Name used by the report */
+    bool                            runs_from_imo;      /**< Exit runs from the IMO, not the PLL */
+    uint32_t                        entry_cycles;       /**< Last CHECK_READY + BEFORE_TRANSITION */
+    uint32_t                        exit_cycles;        /**< Last AFTER_TRANSITION */
+    uint32_t                        max_entry_cycles;   /**< Largest entry_cycles seen */
+    uint32_t                        max_exit_cycles;    /**< Largest exit_cycles seen */
+    struct cybsp_pm_latency_probe*  next;               /**< Next probe, managed by the BSP */
+} cybsp_pm_latency_probe_t;
+
+/** Deep sleep latency report, see \ref cybsp_pm_latency_get_report */
+typedef struct
+{
+    uint32_t transitions;           /**< Number of measured deep sleep transitions */
+    uint32_t entry_us;              /**< Entry latency of the last transition */
+    uint32_t exit_us;               /**< Wake-to-running latency of the last transition */
+    uint32_t clock_restore_us;      /**< Part of exit_us spent restoring the clocks */
+    uint32_t max_entry_us;          /**< Largest entry latency seen */
+    uint32_t max_exit_us;           /**< Largest wake-to-running latency seen */
+    uint32_t max_clock_restore_us;  /**< Largest clock restore time seen */
+    uint32_t pll_relock_us;         /**< Wakeup to the switch back to the PLL in
+                                         \ref cybsp_pm_fast_wake_process, CYBSP_PM_FAST_WAKE only.
+                                         This includes the time until the application called it,
+                                         so it is an upper bound of the PLL lock time. */
+} cybsp_pm_latency_report_t;
+
+/** printf compatible function used to dump the latency report */
+typedef int (*cybsp_pm_latency_print_t)(const char* format, ...);
+
+/**
+ * \brief Enables the cycle counter and registers the boundary callback.
+ * Called by \ref cybsp_init.
+ * \returns CY_RSLT_SUCCESS if the boundary callback was registered, otherwise an error
+ */
+cy_rslt_t cybsp_pm_latency_init(void);
+
+/**
+ * \brief Wraps a power management callback in a latency probe.
+ * Must be called before the callback is registered with Cy_SysPm_RegisterCallback(). The wrapped
+ * callback still receives a parameter structure with the original base and context.
+ * \param probe    Probe object, must stay valid as long as the callback is registered
+ * \param callback Callback structure to wrap, modified in place
+ * \param name     Name shown by \ref cybsp_pm_latency_dump
+ * \returns CY_RSLT_SUCCESS if the callback was wrapped, CYBSP_RSLT_ERR_PM_LATENCY_BAD_ARG otherwise
+ */
+cy_rslt_t cybsp_pm_latency_wrap(cybsp_pm_latency_probe_t* probe,
+                                cy_stc_syspm_callback_t* callback, const char* name);
+
+/**
+ * \brief Returns the deep sleep latency measured so far.
+ * \param report Filled with the latency report
+ */
+void cybsp_pm_latency_get_report(cybsp_pm_latency_report_t* report);
+
+/**
+ * \brief Returns the first latency probe. Further probes are reached through the next member.
+ * \returns The most recently wrapped probe or NULL if there is none
+ */
+const cybsp_pm_latency_probe_t* cybsp_pm_latency_get_probes(void);
+
+/** \brief Clears the report and the per-callback maximums. */
+void cybsp_pm_latency_reset(void);
+
+/**
+ * \brief Prints the latency report and every probe.
+ * \param print_fn printf compatible function used for the output
+ */
+void cybsp_pm_latency_dump(cybsp_pm_latency_print_t print_fn);
+
+#endif // defined(CYBSP_PM_LATENCY)
+
+#if defined(CYBSP_PM_FAST_WAKE)
+
+/**
+ * \brief SysClk deep sleep callback that does not wait for the PLL on wakeup.
+ * Registered by \ref cybsp_init in place of Cy_SysClk_DeepSleepCallback().
+ * \param params Callback parameters
+ * \param mode   Callback mode
+ * \returns The status of Cy_SysClk_DeepSleepCallback()
+ */
+cy_en_syspm_status_t cybsp_pm_fast_wake_callback(cy_stc_syspm_callback_params_t* params,
+                                                 cy_en_syspm_callback_mode_t mode);
+
+/**
+ * \brief Switches the clocks back to the PLL once it has relocked after a fast wakeup.
+ * Call this from the main loop or idle hook, and before changing the performance level. Until it
+ * has completed the system runs from the IMO and SystemCoreClock reflects that.
+ * \returns true if the system runs from the PLL again (or never left it), false if the PLL has not
+ *          locked yet
+ */
+bool cybsp_pm_fast_wake_process(void);
+
+#endif // defined(CYBSP_PM_FAST_WAKE)
+
+/** \} group_bsp_pm_latency */
+
+#ifdef __cplusplus
+}
+#endif // __cplusplus
@@ -0,0 +1,261 @@
+/***********************************************************************************************//**
+ * \file cybsp_power_stats.c
+ *
+ * Description:
+ * Accounts LPTIMER time to the active performance level, Sleep and Deep Sleep.
+ *
+ ***************************************************************************************************
+ * \copyright
+ * Copyright 2023 Cypress Semiconductor Corporation (an Infineon company) or
+ * an affiliate of Cypress Semiconductor Corporation
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ **************************************************************************************************/
+
+#if defined(CYBSP_POWER_STATS)
+
+#include <stdbool.h>
+#include <stddef.h>
+#include "cy_syslib.h"
+#include "cy_syspm.h"
+#include "cybsp.h"
+
+#if defined(__cplusplus)
+extern "C" {
+#endif
+
+typedef struct
+{
+    uint64_t ticks;
+    uint32_t count;
+} cybsp_power_stats_mode_t;
+
+static bool                     cybsp_power_stats_ready = false;
+// Shared LPTIMER tick rate, the LFCLK frequency reported by the HAL
+static uint32_t                 cybsp_power_stats_timer_hz;
+// LPTIMER count at the start of the period not accounted yet
+static uint32_t                 cybsp_power_stats_last;
+static uint64_t                 cybsp_power_stats_active[CYBSP_PERF_LEVEL_COUNT];
+static cybsp_power_stats_mode_t cybsp_power_stats_sleep;
+static cybsp_power_stats_mode_t cybsp_power_stats_deepsleep;
+
+//--------------------------------------------------------------------------------------------------
+// cybsp_power_stats_elapsed
+//
+// Returns the ticks since the last accounted point and restarts the period
+//--------------------------------------------------------------------------------------------------
+static uint32_t cybsp_power_stats_elapsed(void)
+{
+    uint32_t now     = cybsp_lptimer_read();
+    uint32_t elapsed = now - cybsp_power_stats_last;
+    cybsp_power_stats_last = now;
+    return elapsed;
+}
+
+
+//--------------------------------------------------------------------------------------------------
+// cybsp_power_stats_us
+//--------------------------------------------------------------------------------------------------
+static uint64_t cybsp_power_stats_us(uint64_t ticks)
+{
+    // Nothing is accounted before cybsp_power_stats_init()
+    return (0u != cybsp_power_stats_timer_hz)
+        ? ((ticks * 1000000u) / cybsp_power_stats_timer_hz)
+        : 0u;
+}
+
+
+//--------------------------------------------------------------------------------------------------
+// cybsp_power_stats_callback
+//
+// Sleep and Deep Sleep share the callback, the context selects the mode being accounted
+//--------------------------------------------------------------------------------------------------
+static cy_en_syspm_status_t cybsp_power_stats_callback(cy_stc_syspm_callback_params_t* params,
+                                                       cy_en_syspm_callback_mode_t mode)
+{
+    cybsp_power_stats_mode_t* stats = (cybsp_power_stats_mode_t*)params->context;
+
+    if (CY_SYSPM_BEFORE_TRANSITION == mode)
+    {
+        cybsp_power_stats_checkpoint();
+    }
+    else if (CY_SYSPM_AFTER_TRANSITION == mode)
+    {
+        stats->ticks += cybsp_power_stats_elapsed();
+        stats->count++;
+    }
+    return CY_SYSPM_SUCCESS;
+}
+
+
+//--------------------------------------------------------------------------------------------------
+// cybsp_power_stats_init
+//--------------------------------------------------------------------------------------------------
+cy_rslt_t cybsp_power_stats_init(void)
+{
+    static cy_stc_syspm_callback_params_t cybsp_power_stats_sleep_param =
+    {
+        NULL, &cybsp_power_stats_sleep
+    };
+    static cy_stc_syspm_callback_params_t cybsp_power_stats_deepsleep_param =
+    {
+        NULL, &cybsp_power_stats_deepsleep
+    };
+    static cy_stc_syspm_callback_t cybsp_power_stats_sleep_cb =
+    {
+        .callback       = &cybsp_power_stats_callback,
+        .type           = CY_SYSPM_SLEEP,
+        .callbackParams = &cybsp_power_stats_sleep_param,
+        .order          = CYBSP_POWER_STATS_PM_CALLBACK_ORDER
+    };
+    static cy_stc_syspm_callback_t cybsp_power_stats_deepsleep_cb =
+    {
+        .callback       = &cybsp_power_stats_callback,
+        .type           = CY_SYSPM_DEEPSLEEP,
+        .callbackParams = &cybsp_power_stats_deepsleep_param,
+        .order          = CYBSP_POWER_STATS_PM_CALLBACK_ORDER
+    };
+
+    if (cybsp_power_stats_ready)
+    {
+        return CY_RSLT_SUCCESS;
+    }
+
+    cy_rslt_t result = cybsp_lptimer_init();
+    if (CY_RSLT_SUCCESS == result)
+    {
+        cybsp_power_stats_timer_hz = cybsp_lptimer_get_frequency();
+        cybsp_power_stats_last     = cybsp_lptimer_read();
+
+        if (!Cy_SysPm_RegisterCallback(&cybsp_power_stats_sleep_cb))
+        {
+            result = CYBSP_RSLT_ERR_POWER_STATS;
+        }
+        else if (!Cy_SysPm_RegisterCallback(&cybsp_power_stats_deepsleep_cb))
+        {
+            // Leave nothing registered, so a later call can retry from scratch
+            (void)Cy_SysPm_UnregisterCallback(&cybsp_power_stats_sleep_cb);
+            result = CYBSP_RSLT_ERR_POWER_STATS;
+        }
+        else
+        {
+            cybsp_power_stats_ready = true;
+        }
+    }
+    return result;
+}
+
+
+//--------------------------------------------------------------------------------------------------
+// cybsp_power_stats_checkpoint
+//--------------------------------------------------------------------------------------------------
+void cybsp_power_stats_checkpoint(void)
+{
+    if (cybsp_power_stats_ready)
+    {
+        uint32_t savedIntrStatus = Cy_SysLib_EnterCriticalSection();
+        cybsp_power_stats_active[cybsp_get_performance_level()] += cybsp_power_stats_elapsed();
+        Cy_SysLib_ExitCriticalSection(savedIntrStatus);
+    }
+}
+
+
+//--------------------------------------------------------------------------------------------------
+// cybsp_power_stats_get
+//--------------------------------------------------------------------------------------------------
+void cybsp_power_stats_get(cybsp_power_stats_t* stats)
+{
+    CY_ASSERT(NULL != stats);
+
+    uint32_t savedIntrStatus = Cy_SysLib_EnterCriticalSection();
+    cybsp_power_stats_checkpoint();
+    for (uint32_t i = 0u; i < CYBSP_PERF_LEVEL_COUNT; i++)
+    {
+        stats->active_us[i] = cybsp_power_stats_us(cybsp_power_stats_active[i]);
+    }
+    stats->sleep_us        = cybsp_power_stats_us(cybsp_power_stats_sleep.ticks);
+    stats->deepsleep_us    = cybsp_power_stats_us(cybsp_power_stats_deepsleep.ticks);
+    stats->sleep_count     = cybsp_power_stats_sleep.count;
+    stats->deepsleep_count = cybsp_power_stats_deepsleep.count;
+    Cy_SysLib_ExitCriticalSection(savedIntrStatus);
+}
+
+
+//--------------------------------------------------------------------------------------------------
+// cybsp_power_stats_charge
+//--------------------------------------------------------------------------------------------------
+uint64_t cybsp_power_stats_charge(const cybsp_power_stats_t* before,
+                                  const cybsp_power_stats_t* after,
+                                  const cybsp_power_model_t* model)
+{
+    CY_ASSERT((NULL != before) && (NULL != after) && (NULL != model));
+
+    // uA x us is pC
+    uint64_t charge_pc = 0u;
+    for (uint32_t i = 0u; i < CYBSP_PERF_LEVEL_COUNT; i++)
+    {
+        charge_pc += (after->active_us[i] - before->active_us[i]) * model->active_ua[i];
+    }
+    charge_pc += (after->sleep_us - before->sleep_us) * model->sleep_ua;
+    charge_pc += (after->deepsleep_us - before->deepsleep_us) * model->deepsleep_ua;
+    return charge_pc / 1000u;
+}
+
+
+//--------------------------------------------------------------------------------------------------
+// cybsp_power_stats_dump
+//--------------------------------------------------------------------------------------------------
+void cybsp_power_stats_dump(const cybsp_power_stats_t* stats, cybsp_power_stats_print_t print_fn)
+{
+    static const char* const names[CYBSP_PERF_LEVEL_COUNT] = { "active low", "active nominal",
+                                                               "active high" };
+
+    if ((NULL == stats) || (NULL == print_fn))
+    {
+        return;
+    }
+
+    uint64_t total = stats->sleep_us + stats->deepsleep_us;
+    for (uint32_t i = 0u; i < CYBSP_PERF_LEVEL_COUNT; i++)
+    {
+        total += stats->active_us[i];
+    }
+    if (0u == total)
+    {
+        total = 1u;
+    }
+
+    for (uint32_t i = 0u; i < CYBSP_PERF_LEVEL_COUNT; i++)
+    {
+        (void)print_fn("%-15s %10lu ms %3lu%%\r\n", names[i],
+                       (unsigned long)(stats->active_us[i] / 1000u),
+                       (unsigned long)((stats->active_us[i] * 100u) / total));
+    }
+    (void)print_fn("%-15s %10lu ms %3lu%% (%lu entries)\r\n", "sleep",
+                   (unsigned long)(stats->sleep_us / 1000u),
+                   (unsigned long)((stats->sleep_us * 100u) / total),
+                   (unsigned long)stats->sleep_count);
+    (void)print_fn("%-15s %10lu ms %3lu%% (%lu entries)\r\n", "deep sleep",
+                   (unsigned long)(stats->deepsleep_us / 1000u),
+                   (unsigned long)((stats->deepsleep_us * 100u) / total),
+                   (unsigned long)stats->deepsleep_count);
+}
+
+
+#if defined(__cplusplus)
+}
+#endif
+
+#endif // defined(CYBSP_POWER_STATS)
@@ -0,0 +1,127 @@
+/***********************************************************************************************//**
+ * \file cybsp_power_stats.h
+ *
+ * \brief
+ * Accumulated time per power mode and performance level, for energy accounting.
+ *
+ ***************************************************************************************************
+ * \copyright
+ * Copyright 2023 Cypress Semiconductor Corporation (an Infineon company) or
+ * an affiliate of Cypress Semiconductor Corporation
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ **************************************************************************************************/
+
+#pragma once
+
+#include <stdint.h>
+#include "cy_result.h"
+#include "cybsp_clock_profile.h"
+#include "cybsp_lptimer.h"
+
+#if defined(__cplusplus)
+extern "C" {
+#endif
+
+/**
+ * \addtogroup group_bsp_power_stats Power Accounting
+ * \{
+ * When CYBSP_POWER_STATS is defined, the BSP accumulates how long the CM4 spends active at each
+ * \ref cybsp_perf_level_t, in CPU Sleep and in Deep Sleep. The time base is the shared LPTIMER
+ * (\ref group_bsp_lptimer) on the 32.768 kHz WCO, and the mode changes are observed through
+ * Cy_SysPm callbacks, so every way of entering Sleep or Deep Sleep is covered (HAL,
+ * \ref cybsp_sleep_policy_idle, tickless idle). A change of performance level is recorded by
+ * \ref cybsp_set_performance_level.
+ *
+ * Combined with currents measured once per state on a bench, \ref cybsp_power_stats_charge gives
+ * the charge drawn over an interval; taking \ref cybsp_power_stats_get before and after a
+ * transaction gives the charge per transaction.
+ *
+ * \note Time in Sleep includes the transition into and out of it, and Deep Sleep includes the
+ * clock relock on wakeup, so both are slightly overestimated compared to active time.
+ */
+
+#if defined(CYBSP_POWER_STATS)
+
+#if !defined(CYBSP_POWER_STATS_PM_CALLBACK_ORDER)
+/** Order of the Cy_SysPm callbacks, just inside the sysclk callback of the BSP. */
+#define CYBSP_POWER_STATS_PM_CALLBACK_ORDER     (254u)
+#endif
+
+/** Accumulated time per state, in microseconds */
+typedef struct
+{
+    uint64_t active_us[CYBSP_PERF_LEVEL_COUNT]; /**< Active time per performance level */
+    uint64_t sleep_us;                          /**< Time in CPU Sleep */
+    uint64_t deepsleep_us;                      /**< Time in Deep Sleep */
+    uint32_t sleep_count;                       /**< Number of Sleep entries */
+    uint32_t deepsleep_count;                   /**< Number of Deep Sleep entries */
+} cybsp_power_stats_t;
+
+/** Current per state measured for the board, in microamperes */
+typedef struct
+{
+    uint32_t active_ua[CYBSP_PERF_LEVEL_COUNT]; /**< Active current per performance level */
+    uint32_t sleep_ua;                          /**< CPU Sleep current */
+    uint32_t deepsleep_ua;                      /**< Deep Sleep current */
+} cybsp_power_model_t;
+
+/** printf compatible function used to print the statistics */
+typedef int (*cybsp_power_stats_print_t)(const char* format, ...);
+
+/**
+ * \brief Reserves the shared LPTIMER and registers the Sleep and Deep Sleep callbacks. On failure
+ * no callback is left registered and the accounting stays off.
+ * \returns CY_RSLT_SUCCESS, CYBSP_RSLT_ERR_POWER_STATS if a callback could not be registered,
+ *          otherwise the error from \ref cybsp_lptimer_init
+ */
+cy_rslt_t cybsp_power_stats_init(void);
+
+/**
+ * \brief Returns the accumulated times, including the current active period.
+ * \param stats Filled with the statistics
+ */
+void cybsp_power_stats_get(cybsp_power_stats_t* stats);
+
+/**
+ * \brief Returns the charge drawn between two snapshots.
+ * \param before Snapshot taken first
+ * \param after  Snapshot taken last
+ * \param model  Current per state
+ * \returns Charge in nanocoulombs (uA x ms)
+ */
+uint64_t cybsp_power_stats_charge(const cybsp_power_stats_t* before,
+                                  const cybsp_power_stats_t* after,
+                                  const cybsp_power_model_t* model);
+
+/**
+ * \brief Prints the accumulated times and their share of the total.
+ * \param stats    Statistics from \ref cybsp_power_stats_get
+ * \param print_fn printf compatible function used for the output
+ */
+void cybsp_power_stats_dump(const cybsp_power_stats_t* stats, cybsp_power_stats_print_t print_fn);
+
+/** \cond INTERNAL */
+// Accounts the active time up to now to the current performance level
+void cybsp_power_stats_checkpoint(void);
+/** \endcond */
+
+#endif // defined(CYBSP_POWER_STATS)
+
+/** \} group_bsp_power_stats */
+
+#ifdef __cplusplus
+}
+#endif // __cplusplus
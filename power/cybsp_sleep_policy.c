@@ -0,0 +1,172 @@
+/***********************************************************************************************//**
+ * \file cybsp_sleep_policy.c
+ *
+ * Description:
+ * Reference counted deep sleep locks and selection of the deepest allowed idle state.
+ *
+ ***************************************************************************************************
+ * \copyright
+ * Copyright 2023 Cypress Semiconductor Corporation (an Infineon company) or
+ * an affiliate of Cypress Semiconductor Corporation
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ **************************************************************************************************/
+
+#if defined(CYBSP_SLEEP_POLICY)
+
+#include <stddef.h>
+#include "cy_syslib.h"
+#include "cybsp.h"
+#if defined(__MBED__)
+#include "mbed_power_mgmt.h"
+#elif defined(CY_USING_HAL)
+#include "cyhal_syspm.h"
+#endif
+
+#if defined(__cplusplus)
+extern "C" {
+#endif
+
+#if defined(__MBED__)
+    #define CYBSP_SLEEP_POLICY_LOCK_DEEPSLEEP()     sleep_manager_lock_deep_sleep()
+    #define CYBSP_SLEEP_POLICY_UNLOCK_DEEPSLEEP()   sleep_manager_unlock_deep_sleep()
+#else
+    #define CYBSP_SLEEP_POLICY_LOCK_DEEPSLEEP()     cyhal_syspm_lock_deepsleep()
+    #define CYBSP_SLEEP_POLICY_UNLOCK_DEEPSLEEP()   cyhal_syspm_unlock_deepsleep()
+#endif
+
+static uint16_t                   cybsp_sleep_policy_locks[CYBSP_SLEEP_CLIENT_COUNT];
+static uint32_t                   cybsp_sleep_policy_total = 0u;
+static cybsp_sleep_policy_stats_t cybsp_sleep_policy_stats;
+
+//--------------------------------------------------------------------------------------------------
+// cybsp_sleep_policy_lock
+//--------------------------------------------------------------------------------------------------
+void cybsp_sleep_policy_lock(cybsp_sleep_client_t client)
+{
+    CY_ASSERT(client < CYBSP_SLEEP_CLIENT_COUNT);
+
+    uint32_t savedIntrStatus = Cy_SysLib_EnterCriticalSection();
+    CY_ASSERT(UINT16_MAX != cybsp_sleep_policy_locks[client]);
+    cybsp_sleep_policy_locks[client]++;
+    if (0u == cybsp_sleep_policy_total++)
+    {
+        CYBSP_SLEEP_POLICY_LOCK_DEEPSLEEP();
+    }
+    Cy_SysLib_ExitCriticalSection(savedIntrStatus);
+}
+
+
+//--------------------------------------------------------------------------------------------------
+// cybsp_sleep_policy_unlock
+//--------------------------------------------------------------------------------------------------
+cy_rslt_t cybsp_sleep_policy_unlock(cybsp_sleep_client_t client)
+{
+    CY_ASSERT(client < CYBSP_SLEEP_CLIENT_COUNT);
+    cy_rslt_t result = CY_RSLT_SUCCESS;
+
+    uint32_t savedIntrStatus = Cy_SysLib_EnterCriticalSection();
+    if (0u == cybsp_sleep_policy_locks[client])
+    {
+        result = CYBSP_RSLT_ERR_SLEEP_POLICY_UNLOCK;
+    }
+    else
+    {
+        cybsp_sleep_policy_locks[client]--;
+        if (0u == --cybsp_sleep_policy_total)
+        {
+            CYBSP_SLEEP_POLICY_UNLOCK_DEEPSLEEP();
+        }
+    }
+    Cy_SysLib_ExitCriticalSection(savedIntrStatus);
+
+    return result;
+}
+
+
+//--------------------------------------------------------------------------------------------------
+// cybsp_sleep_policy_get_lock_count
+//--------------------------------------------------------------------------------------------------
+uint32_t cybsp_sleep_policy_get_lock_count(cybsp_sleep_client_t client)
+{
+    CY_ASSERT(client < CYBSP_SLEEP_CLIENT_COUNT);
+    return cybsp_sleep_policy_locks[client];
+}
+
+
+//--------------------------------------------------------------------------------------------------
+// cybsp_sleep_policy_idle
+//--------------------------------------------------------------------------------------------------
+cybsp_sleep_state_t cybsp_sleep_policy_idle(void)
+{
+    cybsp_sleep_state_t state = CYBSP_SLEEP_STATE_SLEEP;
+
+    #if defined(__MBED__)
+    // The Mbed sleep manager already picks the deepest state allowed by its lock count
+    if (sleep_manager_can_deep_sleep())
+    {
+        state = CYBSP_SLEEP_STATE_DEEPSLEEP;
+    }
+    sleep_manager_sleep_auto();
+    #else
+    if (0u == cybsp_sleep_policy_total)
+    {
+        // Drivers holding their own HAL lock, or rejecting the transition from their PM
+        // callback, make this fail without entering Deep Sleep.
+        if (CY_RSLT_SUCCESS == cyhal_syspm_deepsleep())
+        {
+            state = CYBSP_SLEEP_STATE_DEEPSLEEP;
+        }
+        else
+        {
+            cybsp_sleep_policy_stats.deepsleep_denied++;
+        }
+    }
+    if (CYBSP_SLEEP_STATE_SLEEP == state)
+    {
+        (void)cyhal_syspm_sleep();
+    }
+    #endif // if defined(__MBED__)
+
+    if (CYBSP_SLEEP_STATE_DEEPSLEEP == state)
+    {
+        cybsp_sleep_policy_stats.deepsleep_count++;
+    }
+    else
+    {
+        cybsp_sleep_policy_stats.sleep_count++;
+    }
+    return state;
+}
+
+
+//--------------------------------------------------------------------------------------------------
+// cybsp_sleep_policy_get_stats
+//--------------------------------------------------------------------------------------------------
+void cybsp_sleep_policy_get_stats(cybsp_sleep_policy_stats_t* stats)
+{
+    CY_ASSERT(NULL != stats);
+
+    uint32_t savedIntrStatus = Cy_SysLib_EnterCriticalSection();
+    *stats = cybsp_sleep_policy_stats;
+    Cy_SysLib_ExitCriticalSection(savedIntrStatus);
+}
+
+
+#if defined(__cplusplus)
+}
+#endif
+
+#endif // defined(CYBSP_SLEEP_POLICY)
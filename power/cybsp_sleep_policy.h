@@ -0,0 +1,122 @@
+/***********************************************************************************************//**
+ * \file cybsp_sleep_policy.h
+ *
+ * \brief
+ * Reference counted deep sleep policy used instead of the permanent deep sleep lock.
+ *
+ ***************************************************************************************************
+ * \copyright
+ * Copyright 2023 Cypress Semiconductor Corporation (an Infineon company) or
+ * an affiliate of Cypress Semiconductor Corporation
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ **************************************************************************************************/
+
+#pragma once
+
+#include <stdint.h>
+#include "cy_result.h"
+
+#if defined(__cplusplus)
+extern "C" {
+#endif
+
+/**
+ * \addtogroup group_bsp_sleep_policy Sleep Policy
+ * \{
+ * When the Device Configurator power settings do not define a system idle mode
+ * (CY_CFG_PWR_SYS_IDLE_MODE), \ref cybsp_init normally locks deep sleep permanently. Defining
+ * CYBSP_SLEEP_POLICY replaces that lock with a reference counted policy: each client takes a
+ * deep sleep lock while it has work in flight and releases it when done, and
+ * \ref cybsp_sleep_policy_idle enters the deepest state allowed at that moment.
+ *
+ * The policy holds a single HAL deep sleep lock while any client lock is held, so drivers that
+ * lock deep sleep through the HAL themselves (e.g. during asynchronous transfers) keep working and
+ * are honored by \ref cybsp_sleep_policy_idle as well.
+ */
+
+#if defined(CYBSP_SLEEP_POLICY)
+
+/** Clients of the sleep policy. Each client has its own lock count. */
+typedef enum
+{
+    CYBSP_SLEEP_CLIENT_APP,         /**< Application code */
+    CYBSP_SLEEP_CLIENT_NETWORK,     /**< Network processor communication (SCL) */
+    CYBSP_SLEEP_CLIENT_BLUETOOTH,   /**< Bluetooth HCI transport */
+    CYBSP_SLEEP_CLIENT_DEBUG_UART,  /**< Debug UART output */
+    CYBSP_SLEEP_CLIENT_COUNT        /**< Number of clients, not a valid client */
+} cybsp_sleep_client_t;
+
+/** Low power state entered by \ref cybsp_sleep_policy_idle */
+typedef enum
+{
+    CYBSP_SLEEP_STATE_SLEEP,        /**< CPU Sleep, deep sleep was locked */
+    CYBSP_SLEEP_STATE_DEEPSLEEP     /**< System Deep Sleep */
+} cybsp_sleep_state_t;
+
+/** Number of low power state entries, see \ref cybsp_sleep_policy_get_stats */
+typedef struct
+{
+    uint32_t sleep_count;           /**< Number of times Sleep was entered */
+    uint32_t deepsleep_count;       /**< Number of times Deep Sleep was entered */
+    uint32_t deepsleep_denied;      /**< Deep Sleep was attempted but rejected by a driver */
+} cybsp_sleep_policy_stats_t;
+
+/**
+ * \brief Prevents deep sleep on behalf of a client.
+ * May be called from interrupt context. Every call must be balanced by
+ * \ref cybsp_sleep_policy_unlock.
+ * \param client Client taking the lock
+ */
+void cybsp_sleep_policy_lock(cybsp_sleep_client_t client);
+
+/**
+ * \brief Releases a deep sleep lock taken by \ref cybsp_sleep_policy_lock.
+ * May be called from interrupt context.
+ * \param client Client releasing the lock
+ * \returns CY_RSLT_SUCCESS if the lock was released, CYBSP_RSLT_ERR_SLEEP_POLICY_UNLOCK if the
+ *          client did not hold a lock
+ */
+cy_rslt_t cybsp_sleep_policy_unlock(cybsp_sleep_client_t client);
+
+/**
+ * \brief Returns the number of deep sleep locks held by a client.
+ * \param client Client to query
+ * \returns The lock count of the client
+ */
+uint32_t cybsp_sleep_policy_get_lock_count(cybsp_sleep_client_t client);
+
+/**
+ * \brief Enters the deepest low power state currently allowed.
+ * Intended to be called from the RTOS idle hook or the bare-metal main loop. Deep Sleep is
+ * attempted when no client holds a lock; if it is locked or rejected by a driver Sleep is entered
+ * instead. Returns after wakeup.
+ * \returns The state that was entered
+ */
+cybsp_sleep_state_t cybsp_sleep_policy_idle(void);
+
+/**
+ * \brief Returns the low power state entry counters.
+ * \param stats Filled with the counters
+ */
+void cybsp_sleep_policy_get_stats(cybsp_sleep_policy_stats_t* stats);
+
+#endif // defined(CYBSP_SLEEP_POLICY)
+
+/** \} group_bsp_sleep_policy */
+
+#ifdef __cplusplus
+}
+#endif // __cplusplus